@@ -199,6 +199,170 @@ config_option(
     DEFAULT_DISABLED OFF
 )
 
+config_option(
+    KernelLookupCache KERNEL_LOOKUP_CACHE
+    "Cache the slot found by full-depth capability lookups in a small per-core table. \
+    Entries are tagged with a global generation that is advanced whenever a CNode cap is \
+    inserted, moved, swapped or removed, which invalidates every cached lookup at once."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelSignalBatch KERNEL_SIGNAL_BATCH
+    "Enable the seL4_SignalBatch system call, which signals a list of notifications \
+    passed in the IPC buffer in a single kernel entry, rescheduling only once at the end."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelArchClearMemory KERNEL_ARCH_CLEAR_MEMORY
+    "Clear memory for untyped reset and new kernel objects with an architecture-specific \
+    engine instead of word-by-word stores: rep stosb on x86 processors with enhanced \
+    rep movsb/stosb, DC ZVA on AArch64 when it is permitted, and cbo.zero on RISC-V when \
+    KernelRiscvExtZicboz is set. The engine is chosen at boot where the hardware reports \
+    support, falling back to the generic loop otherwise."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelCompactTCBLinks KERNEL_COMPACT_TCB_LINKS
+    "Store the scheduler and endpoint queue links of a TCB as signed 32-bit distances \
+    from the TCB holding the link to the TCB it refers to, counted in units of the TCB \
+    object size, instead of as pointers, halving their size on 64-bit kernels."
+    DEFAULT OFF
+    DEPENDS "KernelWordSize EQUAL 64;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelTCBSpawn KERNEL_TCB_SPAWN
+    "Enable seL4_TCB_Spawn, which configures a thread's CSpace, VSpace, IPC buffer, \
+    priorities, affinity and registers and resumes it in a single invocation."
+    DEFAULT OFF
+    DEPENDS "NOT KernelIsMCS;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelUntypedReclaim KERNEL_UNTYPED_RECLAIM
+    "Enable seL4_Untyped_Reclaim, which lowers the free index of an untyped to the end \
+    of its highest remaining child, so that memory of deleted children at the top of the \
+    region can be retyped again without revoking the other children."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelCNodeBatch KERNEL_CNODE_BATCH
+    "Enable seL4_CNode_Batch, which applies a list of copy, mint, move and delete \
+    operations read from the IPC buffer in a single preemptible invocation and records \
+    the outcome of each operation in its entry."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelMDBStats KERNEL_MDB_STATS
+    "Enable seL4_CNode_MDBStats, which walks the capability derivation tree below a slot \
+    and reports its size, depth, fan-out histogram and per-type capability counts. The \
+    walk is preemptible and resumes where it stopped unless the tree changed meanwhile."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelRevokeBatch KERNEL_REVOKE_BATCH
+    "Revoke leaf capabilities in batches. A run of children that have no descendants \
+    of their own and cannot become Zombies is deleted between two preemption points, \
+    and on SMP x86 the TLB shootdowns for frames unmapped in the run are sent as one \
+    IPI at the end of the run instead of one per frame."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+config_string(
+    KernelRevokeBatchSize REVOKE_BATCH_SIZE
+    "Maximum number of capabilities deleted between two preemption points by a batched \
+    revoke. This bounds the extra interrupt latency of KernelRevokeBatch."
+    DEFAULT 32
+    UNQUOTE
+    DEPENDS "KernelRevokeBatch"
+)
+
+config_option(
+    KernelRetypeBatch KERNEL_RETYPE_BATCH
+    "Enable seL4_Untyped_RetypeBatch, which creates objects of several types and sizes \
+    from one untyped in a single invocation. The batch is described by entries in the \
+    IPC buffer and is bounded as a whole by KernelRetypeFanOutLimit."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelLazyUntypedZero KERNEL_LAZY_UNTYPED_ZERO
+    "Clear untyped memory lazily. Resetting an untyped records how much of it may hold \
+    stale data instead of clearing it, retypes only clear the memory of the objects they \
+    create, and seL4_Untyped_ClearFree lets a low-priority thread clear the rest ahead \
+    of time."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelIPCPageGrant KERNEL_IPC_PAGE_GRANT
+    "Enable page-grant IPC transfers. A sender that sets seL4_TCBFlag_grantFrames moves \
+    frame caps sent over a grant endpoint instead of copying them. The kernel unmaps the \
+    frame from the sender and maps it into the receive window that the receiver registered \
+    with seL4_TCB_SetGrantWindow, as part of the IPC."
+    DEFAULT OFF
+    DEPENDS "KernelArchX86;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelBulkCapTransfer KERNEL_BULK_CAP_TRANSFER
+    "Enable bulk capability transfers over IPC. A sender can name up to one message's worth \
+    of capabilities in its message registers, and the kernel copies them into a window of \
+    consecutive receive slots nominated by the receiver, in a single IPC."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelRing KERNEL_RING
+    "Enable ring objects. A ring pairs a notification with a user-mapped single-producer \
+    single-consumer ring buffer header. The kernel checks the ring for pending records \
+    before blocking the consumer and publishes whether the consumer is blocked, so that \
+    producers only need to signal on the empty to non-empty edge."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelRootserverLargePages ROOTSERVER_LARGE_PAGES
+    "Map the parts of the initial thread's image and extra bootinfo region that cover \
+    whole large pages with large frames instead of small ones, where the physical and \
+    virtual addresses are congruent modulo the large page size. This saves the page \
+    tables and most of the frame caps for a large image. The large frame caps are \
+    reported in seL4_BootInfo."
+    DEFAULT OFF
+    DEPENDS "KernelSel4ArchAarch64;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
 find_file(
     KernelDomainSchedule default_domain.c
     PATHS src/config
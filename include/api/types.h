@@ -41,6 +41,9 @@ struct cap_transfer {
     cptr_t ctReceiveRoot;
     cptr_t ctReceiveIndex;
     word_t ctReceiveDepth;
+#ifdef CONFIG_KERNEL_BULK_CAP_TRANSFER
+    word_t ctReceiveCount;
+#endif
 };
 typedef struct cap_transfer cap_transfer_t;
 
@@ -67,7 +70,12 @@ static inline cap_transfer_t PURE capTransferFromWords(word_t *wptr)
 
     transfer.ctReceiveRoot  = (cptr_t)wptr[0];
     transfer.ctReceiveIndex = (cptr_t)wptr[1];
+#ifdef CONFIG_KERNEL_BULK_CAP_TRANSFER
+    transfer.ctReceiveDepth = wptr[2] & MASK(seL4_CapReceiveWindowShift);
+    transfer.ctReceiveCount = wptr[2] >> seL4_CapReceiveWindowShift;
+#else
     transfer.ctReceiveDepth = wptr[2];
+#endif
     return transfer;
 }
 
@@ -27,6 +27,20 @@ compile_assert(SysReplyRecv_Minus2, SysReplyRecv == -2)
 #define endpoint_ptr_get_epQueue_tail_fp(ep_ptr) TCB_PTR(endpoint_ptr_get_epQueue_tail(ep_ptr))
 #define cap_vtable_cap_get_vspace_root_fp(vtable_cap) VSPACE_PTR(cap_vspace_cap_get_capVSBasePtr(vtable_cap))
 
+#ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
+/* Whether the VMID stored in an ASID map can be loaded on this core
+ * without going through getHWASID */
+static inline bool_t FORCE_INLINE isVMIDCurrent_fp(asid_map_t asid_map)
+{
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+    return asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map) &&
+           asid_map_asid_map_vspace_get_vmid_generation(asid_map) == ARCH_NODE_STATE(armKSVMIDCoreGeneration);
+#else
+    return asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map);
+#endif
+}
+#endif
+
 static inline void FORCE_INLINE
 switchToThread_fp(tcb_t *thread, vspace_root_t *vroot, pde_t stored_hw_asid)
 {
@@ -37,6 +51,11 @@ switchToThread_fp(tcb_t *thread, vspace_root_t *vroot, pde_t stored_hw_asid)
     }
     asid = (asid_t)(stored_hw_asid.words[0] & 0xffff);
     armv_contextSwitch_HWASID(vroot, asid);
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+    ARCH_NODE_STATE(armKSActiveASID) =
+        cap_vspace_cap_get_capVSMappedASID(TCB_PTR_CTE_PTR(thread, tcbVTable)->cap);
+    ARCH_NODE_STATE(armKSActiveVMID) = asid;
+#endif
 
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
     benchmark_utilisation_switch(NODE_STATE(ksCurThread), thread);
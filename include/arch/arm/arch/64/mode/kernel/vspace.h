@@ -19,6 +19,9 @@ bool_t CONST isVTableRoot(cap_t cap);
 bool_t CONST isValidNativeRoot(cap_t cap);
 
 void unmapPageTable(asid_t asid, vptr_t vaddr, pte_t *pt);
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+void unmapSharedPageTable(cap_t cap, bool_t final);
+#endif
 void unmapPage(vm_page_size_t page_size, asid_t asid, vptr_t vptr, pptr_t pptr);
 
 void deleteASIDPool(asid_t base, asid_pool_t *pool);
@@ -45,10 +48,17 @@ static inline exception_t performASIDPoolInvocation(asid_t asid, asid_pool_t *po
 #ifdef CONFIG_ARM_SMMU
                               /* bind_cb: Number of bound context banks */
                               0,
+#endif
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+                              /* stored_hw_vmid: Assigned hardware VMID for TLB. */
+                              0,
 #endif
                               /* vspace_root: reference to vspace root page table object */
                               cap_vspace_cap_get_capVSBasePtr(cap)
-#ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
+#if defined(CONFIG_ARM_VMID_GENERATIONS)
+                              /* vmid_generation, stored_vmid_valid: Allocator generation of the stored VMID. */
+                              , 0, false
+#elif defined(CONFIG_ARM_HYPERVISOR_SUPPORT)
                               /* stored_hw_vmid, stored_vmid_valid: Assigned hardware VMID for TLB. */
                               , 0, false
 #endif
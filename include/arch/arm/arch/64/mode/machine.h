@@ -275,6 +275,16 @@ static inline void invalidateLocalTLB_IPA(word_t ipa)
     isb();
 }
 
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+/* ID_AA64MMFR1_EL1.VMIDBits reads 2 when 16-bit VMIDs are supported */
+static inline bool_t has16BitVMIDs(void)
+{
+    word_t mmfr1;
+    MRS("id_aa64mmfr1_el1", mmfr1);
+    return ((mmfr1 >> 4) & 0xf) == 2;
+}
+#endif
+
 void lockTLBEntry(vptr_t vaddr);
 
 static inline void cleanByVA(vptr_t vaddr, paddr_t paddr)
@@ -318,6 +328,35 @@ static inline void cleanInvalByVA(vptr_t vaddr, paddr_t paddr)
     dsb();
 }
 
+#ifdef CONFIG_ARM_CACHE_FLUSH_BATCH
+/* Variants of the above without a barrier, for batches of operations that
+ * are completed together by a single dsb. */
+static inline void cleanByVA_nobarrier(vptr_t vaddr)
+{
+    asm volatile("dc cvac, %0" : : "r"(vaddr));
+}
+
+static inline void cleanByVA_PoU_nobarrier(vptr_t vaddr)
+{
+    asm volatile("dc cvau, %0" : : "r"(vaddr));
+}
+
+static inline void invalidateByVA_nobarrier(vptr_t vaddr)
+{
+    asm volatile("dc ivac, %0" : : "r"(vaddr));
+}
+
+static inline void invalidateByVA_I_nobarrier(vptr_t vaddr)
+{
+    asm volatile("ic ivau, %0" : : "r"(vaddr));
+}
+
+static inline void cleanInvalByVA_nobarrier(vptr_t vaddr)
+{
+    asm volatile("dc civac, %0" : : "r"(vaddr));
+}
+#endif
+
 static inline void branchFlush(vptr_t vaddr, paddr_t paddr)
 {
 
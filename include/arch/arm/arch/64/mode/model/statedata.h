@@ -22,6 +22,9 @@
 
 /* The top level asid mapping table */
 extern asid_pool_t *armKSASIDTable[nASIDPools] VISIBLE;
+#ifdef CONFIG_KERNEL_ARCH_CLEAR_MEMORY
+extern word_t armKSZeroBlockBits;
+#endif
 
 /* This is the temporary userspace page table in kernel. It is required before running
  * user thread to avoid speculative page table walking with the wrong page table. */
@@ -33,10 +36,21 @@ extern pte_t armKSGlobalKernelPDs[BIT(PT_INDEX_BITS)][BIT(PT_INDEX_BITS)] VISIBL
 extern pte_t armKSGlobalKernelPT[BIT(PT_INDEX_BITS)] VISIBLE;
 
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
-
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+extern word_t armKSVMIDBitmap[BIT(VMID_MAX_BITS) / wordBits];
+extern word_t armKSVMIDBits;
+extern word_t armKSVMIDGeneration;
+extern word_t armKSNextVMID;
+#else
 extern asid_t armKSHWASIDTable[BIT(hwASIDBits)] VISIBLE;
 extern hw_asid_t armKSNextASID VISIBLE;
 #endif
+#endif
+
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+extern shared_pt_t armKSSharedPTs[CONFIG_ARM_MAX_SHARED_PAGE_TABLES];
+extern word_t armKSNumSharedPTs;
+#endif
 
 #ifdef CONFIG_KERNEL_LOG_BUFFER
 extern pte_t *armKSGlobalLogPTE;
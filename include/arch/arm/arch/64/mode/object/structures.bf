@@ -38,7 +38,12 @@ block page_table_cap {
     field_high capPTBasePtr          48
 
     field capType                    5
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+    padding                          9
+    field capPTIsShared              1
+#else
     padding                          10
+#endif
     field capPTIsMapped              1
     field_high capPTMappedAddress    28
     padding                          20
@@ -165,6 +170,9 @@ tagged_union cap capType {
     tag sched_context_cap           22
     tag sched_control_cap           24
 #endif
+#ifdef CONFIG_KERNEL_RING
+    tag ring_cap                    26
+#endif
 
     -- 5-bit tag arch caps
     tag frame_cap                   1
@@ -247,11 +255,16 @@ block asid_map_vspace {
 #ifdef CONFIG_ARM_SMMU
     field bind_cb                   8
     padding                         8
+#elif defined(CONFIG_ARM_VMID_GENERATIONS)
+    field stored_hw_vmid            16
 #else
     padding                         16
 #endif
     field_high vspace_root          36
-#ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
+#if defined(CONFIG_ARM_VMID_GENERATIONS)
+    field vmid_generation           10
+    field stored_vmid_valid         1
+#elif defined(CONFIG_ARM_HYPERVISOR_SUPPORT)
     padding                         2
     field stored_hw_vmid            8
     field stored_vmid_valid         1
@@ -273,9 +286,21 @@ base 64(48,0)
 -- See the definition of pte_type for explanation
 -- for pte_sw_type and pte_hw_type
 block pte_table {
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+    -- no_write is APTable[1], which removes write access to everything mapped
+    -- below the entry. shared uses a bit the hardware ignores in table
+    -- descriptors and marks the link of a shared page table into a sharer.
+    padding                         1
+    field no_write                  1
+    padding                         3
+    field pte_sw_type               1
+    field shared                    1
+    padding                         9
+#else
     padding                         5
     field pte_sw_type               1
     padding                         10
+#endif
     field_high pt_base_address      36
     padding                         10
     field pte_hw_type               2
@@ -288,7 +313,9 @@ block pte_page {
     field pte_sw_type               1
     padding                         3
     field UXN                       1
-    padding                         6
+    padding                         1
+    field contiguous                1
+    padding                         4
     field_high page_base_address    36
     field nG                        1
     field AF                        1
@@ -309,7 +336,9 @@ block pte_4k_page {
     field pte_sw_type               1
     padding                         3
     field UXN                       1
-    padding                         6
+    padding                         1
+    field contiguous                1
+    padding                         4
     field_high page_base_address    36
     field nG                        1
     field AF                        1
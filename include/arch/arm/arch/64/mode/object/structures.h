@@ -63,6 +63,19 @@ struct asid_pool {
 };
 typedef struct asid_pool asid_pool_t;
 
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+/* A page table mapped by its owner at vaddr that is also linked into the
+ * VSpaces of sharers, see seL4_ARM_PageTable_MapShared. The entry is free
+ * when pt is NULL, and owner is asidInvalid once the owner's VSpace has
+ * been deleted. */
+typedef struct shared_pt {
+    pte_t *pt;
+    vptr_t vaddr;
+    asid_t owner;
+    word_t sharers;
+} shared_pt_t;
+#endif
+
 /* Generic fastpath.c code expects pde_t for stored_hw_asid
  * that's a workaround in the time being.
  */
@@ -230,3 +243,23 @@ static inline uint64_t pte_page_ptr_get_page_base_address(pte_t *pt)
 {
     return pte_get_page_base_address(*pt);
 }
+
+/** Return the contiguous hint for both of pte_4k_page and pte_page */
+static inline bool_t pte_get_contiguous(pte_t pte)
+{
+    assert(pte_is_page_type(pte));
+    if (pte_get_pte_type(pte) == pte_pte_4k_page) {
+        return pte_pte_4k_page_get_contiguous(pte);
+    }
+    return pte_pte_page_get_contiguous(pte);
+}
+
+/** Set the contiguous hint for both of pte_4k_page and pte_page */
+static inline pte_t pte_set_contiguous(pte_t pte, bool_t contiguous)
+{
+    assert(pte_is_page_type(pte));
+    if (pte_get_pte_type(pte) == pte_pte_4k_page) {
+        return pte_pte_4k_page_set_contiguous(pte, contiguous);
+    }
+    return pte_pte_page_set_contiguous(pte, contiguous);
+}
@@ -43,16 +43,29 @@ void cleanInvalidate_L1D(void);
 void cleanCaches_PoU(void);
 void cleanInvalidateL1Caches(void);
 
+#if defined(CONFIG_KERNEL_ARCH_CLEAR_MEMORY) && defined(CONFIG_ARCH_AARCH64)
+void initClearMemory(void);
+void clearMemory_ZVA(void *ptr, word_t n);
+#endif
+
 /* Cleaning memory before user-level access. Does not flush cache. */
 static inline void clearMemory(word_t *ptr, word_t bits)
 {
+#if defined(CONFIG_KERNEL_ARCH_CLEAR_MEMORY) && defined(CONFIG_ARCH_AARCH64)
+    clearMemory_ZVA(ptr, BIT(bits));
+#else
     memzero(ptr, BIT(bits));
+#endif
 }
 
 /* Cleaning memory before page table walker access */
 static inline void clearMemory_PT(word_t *ptr, word_t bits)
 {
+#if defined(CONFIG_KERNEL_ARCH_CLEAR_MEMORY) && defined(CONFIG_ARCH_AARCH64)
+    clearMemory_ZVA(ptr, BIT(bits));
+#else
     memzero(ptr, BIT(bits));
+#endif
     cleanCacheRange_PoU((word_t)ptr, (word_t)ptr + BIT(bits) - 1,
                         addrFromPPtr(ptr));
 }
@@ -19,6 +19,13 @@ NODE_STATE_DECLARE(word_t, ipiReschedulePending);
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
 NODE_STATE_DECLARE(vcpu_t, *armHSCurVCPU);
 NODE_STATE_DECLARE(bool_t, armHSVCPUActive);
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+/* VMID generation whose TLB state this core has been flushed for */
+NODE_STATE_DECLARE(word_t, armKSVMIDCoreGeneration);
+/* ASID and VMID last loaded into VTTBR_EL2 on this core */
+NODE_STATE_DECLARE(asid_t, armKSActiveASID);
+NODE_STATE_DECLARE(hw_asid_t, armKSActiveVMID);
+#endif
 #if defined(CONFIG_ARCH_AARCH32) && defined(CONFIG_HAVE_FPU)
 NODE_STATE_DECLARE(bool_t, armHSFPUEnabled);
 #endif
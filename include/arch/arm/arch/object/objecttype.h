@@ -30,6 +30,17 @@ static inline void Arch_postCapDeletion(cap_t cap)
 {
 }
 
+#ifdef CONFIG_KERNEL_REVOKE_BATCH
+/* Bracket the deletions of a batched revoke, see cteRevokeBatch */
+static inline void Arch_beginRevokeBatch(void)
+{
+}
+
+static inline void Arch_endRevokeBatch(void)
+{
+}
+#endif
+
 /**
  * Return true if the given arch cap can be a descendant of an IRQControlCap.
  */
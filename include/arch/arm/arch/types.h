@@ -23,13 +23,27 @@ typedef word_t node_id_t;
 typedef word_t cpu_id_t;
 typedef word_t dom_t;
 
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+typedef uint16_t hw_asid_t;
+#else
 typedef uint8_t  hw_asid_t;
+#endif
 
 enum hwASIDConstants {
     hwASIDMax = 255,
     hwASIDBits = 8
 };
 
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+/* Widest VMID the generation allocator can use, and the width of the
+ * generation number kept next to each stored VMID. */
+#define VMID_MAX_BITS 16
+#define VMID_GENERATION_BITS 10
+/* Never a valid generation, forces a core to flush before it next
+ * loads a VMID. */
+#define VMID_GENERATION_INVALID BIT(VMID_GENERATION_BITS)
+#endif
+
 typedef struct kernel_frame {
     paddr_t paddr;
     pptr_t pptr;
@@ -63,6 +63,7 @@
 #define VTCR_EL2_SH0(x)     (((x) & 0x3) << 12)
 #define VTCR_EL2_TG0(x)     (((x) & 0x3) << 14)
 #define VTCR_EL2_PS(x)      (((x) & 0x7) << 16)
+#define VTCR_EL2_VS         BIT(19)
 
 /* Physical address size */
 #define PS_4G               0
@@ -606,6 +607,11 @@ static inline void vcpu_init_vtcr(void)
     vtcr_el2 |= VTCR_EL2_SH0(SH0_INNER);                     // inner shareable
     vtcr_el2 |= VTCR_EL2_TG0(TG0_4K);                        // 4KiB page size
     vtcr_el2 |= BIT(31);                                     // reserved as 1
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+    if (has16BitVMIDs()) {
+        vtcr_el2 |= VTCR_EL2_VS;                             // 16-bit VMID
+    }
+#endif
 
     MSR(REG_VTCR_EL2, vtcr_el2);
     isb();
@@ -87,6 +87,9 @@ tagged_union cap capType {
     tag sched_context_cap   0x4e
     tag sched_control_cap   0x5e
 #endif
+#ifdef CONFIG_KERNEL_RING
+    tag ring_cap            0x6e
+#endif
 }
 
 ---- Arch-independent object types
@@ -131,4 +134,12 @@ block satp {
     field asid          9
     field ppn           22
 }
+
+-- ASID pool entry on SMP: the VSpace root assigned to the ASID and the
+-- cores that have run with it since it was assigned.
+block asid_map {
+    field      hartMask        12
+    field_high vspace_root     20
+}
+
 #include <sel4/arch/shared_types.bf>
@@ -27,10 +27,18 @@ block frame_cap {
     padding                         9
 
     field       capType             5
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    field       capFSize            3
+#else
     field       capFSize            2
+#endif
     field       capFVMRights        2
     field       capFIsDevice        1
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    padding                         14
+#else
     padding                         15
+#endif
     field_high  capFMappedAddress   39
 }
 
@@ -82,6 +90,9 @@ tagged_union cap capType {
     tag sched_context_cap   22
     tag sched_control_cap   24
 #endif
+#ifdef CONFIG_KERNEL_RING
+    tag ring_cap            26
+#endif
 
     -- 5-bit tag arch caps
     tag frame_cap           1
@@ -143,4 +154,12 @@ block satp {
     field ppn           44
 }
 
+-- ASID pool entry on SMP: the VSpace root assigned to the ASID and the
+-- cores that have run with it since it was assigned.
+block asid_map {
+    field      hartMask        32
+    padding                    5
+    field_high vspace_root     27
+}
+
 #include <sel4/arch/shared_types.bf>
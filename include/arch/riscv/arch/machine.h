@@ -64,6 +64,51 @@ compile_assert(kernel_elf_no_overflow, KERNEL_ELF_BASE_RAW < KERNEL_ELF_BASE_RAW
 #define SIE_MEIE  11 /* M-Mode external interrupt enable (MIP only). */
 /* Bit 12 and above are reserved. */
 
+#ifdef CONFIG_RISCV_EXT_SVINVAL
+/* Svinval splits sfence.vma into an ordering fence, any number of sinval.vma
+ * invalidations and a final fence, so a batch of invalidations pays for the
+ * pipeline synchronisation only once. The instructions are emitted with .insn
+ * so that the toolchain does not need to know about the extension. */
+static inline void sfence_w_inval(void)
+{
+    asm volatile(".insn r 0x73, 0, 0x0c, x0, x0, x0" ::: "memory");
+}
+
+static inline void sfence_inval_ir(void)
+{
+    asm volatile(".insn r 0x73, 0, 0x0c, x0, x0, x1" ::: "memory");
+}
+
+static inline void sinval_vma(word_t vaddr, asid_t asid)
+{
+    asm volatile(".insn r 0x73, 0, 0x0b, x0, %0, %1" :: "r"(vaddr), "r"(asid) : "memory");
+}
+
+/* rs1 must be x0 to invalidate every address in the ASID, as with
+ * sfence.vma x0, asid. A register holding 0 would only invalidate VA 0. */
+static inline void sinval_vma_asid(asid_t asid)
+{
+    asm volatile(".insn r 0x73, 0, 0x0b, x0, x0, %0" :: "r"(asid) : "memory");
+}
+
+static inline void hwASIDInvalLocal(asid_t asid)
+{
+    sfence_w_inval();
+    sinval_vma_asid(asid);
+    sfence_inval_ir();
+}
+
+/* Invalidate n pages of size BIT(pageBits) starting at vaddr on this core */
+static inline void hwPagesFlushLocal(asid_t asid, word_t vaddr, word_t n, word_t pageBits)
+{
+    sfence_w_inval();
+    for (word_t i = 0; i < n; i++) {
+        sinval_vma(vaddr + (i << pageBits), asid);
+    }
+    sfence_inval_ir();
+}
+#endif /* CONFIG_RISCV_EXT_SVINVAL */
+
 #ifdef ENABLE_SMP_SUPPORT
 
 static inline void fence_rw_rw(void)
@@ -91,17 +136,23 @@ static inline void sfence_local(void)
     asm volatile("sfence.vma" ::: "memory");
 }
 
-static inline word_t get_sbi_mask_for_all_remote_harts(void)
+/* Convert a mask of core indices to an SBI hart mask, leaving out the current core */
+static inline word_t get_sbi_mask_for_remote_harts(word_t cpuMask)
 {
     word_t mask = 0;
     for (int i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
-        if (i != getCurrentCPUIndex()) {
+        if (i != getCurrentCPUIndex() && (cpuMask & BIT(i))) {
             mask |= BIT(cpuIndexToID(i));
         }
     }
     return mask;
 }
 
+static inline word_t get_sbi_mask_for_all_remote_harts(void)
+{
+    return get_sbi_mask_for_remote_harts(MASK(CONFIG_MAX_NUM_NODES));
+}
+
 static inline void ifence(void)
 {
     ifence_local();
@@ -119,7 +170,11 @@ static inline void sfence(void)
 
 static inline void hwASIDFlushLocal(asid_t asid)
 {
+#ifdef CONFIG_RISCV_EXT_SVINVAL
+    hwASIDInvalLocal(asid);
+#else
     asm volatile("sfence.vma x0, %0" :: "r"(asid): "memory");
+#endif
 }
 
 static inline void hwASIDFlush(asid_t asid)
@@ -129,6 +184,18 @@ static inline void hwASIDFlush(asid_t asid)
     sbi_remote_sfence_vma_asid(mask, 0, 0, asid);
 }
 
+/* Flush an ASID on the cores in cpuMask only. Cores outside the mask have
+ * never run with the ASID, so cannot hold translations for it. */
+static inline void hwASIDFlushCores(asid_t asid, word_t cpuMask)
+{
+    fence_w_rw();
+    hwASIDFlushLocal(asid);
+    word_t mask = get_sbi_mask_for_remote_harts(cpuMask);
+    if (mask != 0) {
+        sbi_remote_sfence_vma_asid(mask, 0, 0, asid);
+    }
+}
+
 #else
 
 static inline void sfence(void)
@@ -138,7 +205,11 @@ static inline void sfence(void)
 
 static inline void hwASIDFlush(asid_t asid)
 {
+#ifdef CONFIG_RISCV_EXT_SVINVAL
+    hwASIDInvalLocal(asid);
+#else
     asm volatile("sfence.vma x0, %0" :: "r"(asid): "memory");
+#endif
 }
 
 #endif /* end of !ENABLE_SMP_SUPPORT */
@@ -149,6 +220,15 @@ void setNextPC(tcb_t *thread, word_t v);
 /* Cleaning memory before user-level access. Does not flush cache. */
 static inline void clearMemory(void *ptr, unsigned int bits)
 {
+#if defined(CONFIG_KERNEL_ARCH_CLEAR_MEMORY) && defined(CONFIG_RISCV_EXT_ZICBOZ)
+    if (bits >= L1_CACHE_LINE_SIZE_BITS) {
+        for (word_t p = (word_t)ptr; p < (word_t)ptr + BIT(bits); p += L1_CACHE_LINE_SIZE) {
+            /* cbo.zero (p), encoded directly for assemblers without Zicboz */
+            asm volatile(".insn i 0x0f, 2, x0, %0, 4" :: "r"(p) : "memory");
+        }
+        return;
+    }
+#endif
     memzero(ptr, BIT(bits));
 }
 
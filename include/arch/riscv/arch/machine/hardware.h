@@ -90,7 +90,10 @@ enum frameSizeConstants {
     RISCVGigaPageBits    = seL4_HugePageBits,
 #endif
 #if CONFIG_PT_LEVELS > 3
-    RISCVTeraPageBits    = seL4_TeraPageBits
+    RISCVTeraPageBits    = seL4_TeraPageBits,
+#endif
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    RISCVNapotPageBits   = seL4_NapotPageBits,
 #endif
 };
 
@@ -98,7 +101,11 @@ enum vm_page_size {
     RISCV_4K_Page,
     RISCV_Mega_Page,
     RISCV_Giga_Page,
-    RISCV_Tera_Page
+    RISCV_Tera_Page,
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    /* Mapped with NAPOT entries in a last-level page table */
+    RISCV_64K_Page
+#endif
 };
 typedef word_t vm_page_size_t;
 
@@ -121,6 +128,11 @@ static inline word_t CONST pageBitsForSize(vm_page_size_t pagesize)
         return RISCVTeraPageBits;
 #endif
 
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    case RISCV_64K_Page:
+        return RISCVNapotPageBits;
+#endif
+
     default:
         fail("Invalid page size");
     }
@@ -21,11 +21,57 @@
 #define tcbArchCNodeEntries tcbCNodeEntries
 
 struct asid_pool {
+#ifdef ENABLE_SMP_SUPPORT
+    asid_map_t array[BIT(asidLowBits)];
+#else
     pte_t *array[BIT(asidLowBits)];
+#endif
 };
 
 typedef struct asid_pool asid_pool_t;
 
+#ifdef ENABLE_SMP_SUPPORT
+/* The hart mask of an ASID records, by core index, every core that may hold
+ * translations for it, so that TLB shootdowns for the ASID only need to reach
+ * those cores. */
+compile_assert(asid_map_hart_mask_fits, CONFIG_MAX_NUM_NODES <= (wordBits == 64 ? 32 : 12))
+
+static inline pte_t *asid_pool_get_vspace_root(asid_pool_t *pool, word_t index)
+{
+    return (pte_t *)asid_map_get_vspace_root(pool->array[index]);
+}
+
+static inline void asid_pool_set_vspace_root(asid_pool_t *pool, word_t index, pte_t *vspace_root)
+{
+    pool->array[index] = asid_map_new(0, (word_t)vspace_root);
+}
+
+static inline word_t asid_pool_get_hart_mask(asid_pool_t *pool, word_t index)
+{
+    return asid_map_get_hartMask(pool->array[index]);
+}
+
+static inline void asid_pool_add_hart(asid_pool_t *pool, word_t index, word_t cpu)
+{
+    word_t mask = asid_map_get_hartMask(pool->array[index]);
+
+    /* Avoid dirtying the pool line when the core is already recorded */
+    if (!(mask & BIT(cpu))) {
+        pool->array[index] = asid_map_set_hartMask(pool->array[index], mask | BIT(cpu));
+    }
+}
+#else
+static inline pte_t *asid_pool_get_vspace_root(asid_pool_t *pool, word_t index)
+{
+    return pool->array[index];
+}
+
+static inline void asid_pool_set_vspace_root(asid_pool_t *pool, word_t index, pte_t *vspace_root)
+{
+    pool->array[index] = vspace_root;
+}
+#endif /* ENABLE_SMP_SUPPORT */
+
 #define ASID_POOL_PTR(r)    ((asid_pool_t*)r)
 #define ASID_POOL_REF(p)    ((word_t)p)
 #define ASID_BITS           (asidHighBits + asidLowBits)
@@ -61,6 +107,37 @@ typedef pte_t pde_t;
 #define PTE_SIZE_BITS   seL4_PageTableEntryBits
 #define PT_INDEX_BITS   seL4_PageTableIndexBits
 
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+/* A Svnapot 64K mapping is made of 16 identical 4K leaf PTEs that have the N
+ * bit (bit 63, outside the generated pte fields) set and ppn[3:0] = 0b1000. */
+#define PTE_NAPOT_BIT       BIT(63)
+#define PTE_NAPOT_64K_PPN   0x8ul
+#define PTE_NAPOT_PPN_BITS  (seL4_NapotPageBits - seL4_PageBits)
+#define PTE_NAPOT_ENTRIES   BIT(PTE_NAPOT_PPN_BITS)
+
+static inline bool_t pte_ptr_is_napot(pte_t *pte)
+{
+    return !!(pte->words[0] & PTE_NAPOT_BIT);
+}
+
+static inline pte_t CONST pte_make_napot(pte_t pte)
+{
+    pte = pte_set_ppn(pte, (pte_get_ppn(pte) & ~MASK(PTE_NAPOT_PPN_BITS)) | PTE_NAPOT_64K_PPN);
+    pte.words[0] |= PTE_NAPOT_BIT;
+    return pte;
+}
+
+/* The ppn of the first 4K page of the mapping that the PTE belongs to */
+static inline word_t pte_ptr_get_base_ppn(pte_t *pte)
+{
+    word_t ppn = pte_ptr_get_ppn(pte);
+    if (pte_ptr_is_napot(pte)) {
+        ppn &= ~MASK(PTE_NAPOT_PPN_BITS);
+    }
+    return ppn;
+}
+#endif /* CONFIG_RISCV_EXT_SVNAPOT */
+
 #define WORD_BITS   (8 * sizeof(word_t))
 #define WORD_PTR(r) ((word_t *)(r))
 
@@ -220,6 +220,9 @@ tagged_union cap capType {
     tag sched_context_cap   0x4e
     tag sched_control_cap   0x5e
 #endif
+#ifdef CONFIG_KERNEL_RING
+    tag ring_cap            0x6e
+#endif
 
     -- 8-bit tag arch caps
 #ifdef CONFIG_IOMMU
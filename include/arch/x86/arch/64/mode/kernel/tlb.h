@@ -18,6 +18,15 @@
  */
 static inline void invalidateLocalASID(vspace_root_t *vspace, asid_t asid)
 {
+#ifdef CONFIG_X86_LAZY_VSPACE_SWITCH
+    /* An idle core may still have this vspace loaded from the thread that ran
+     * before it. Move it to the kernel page table, as the vspace may be about
+     * to be deleted. */
+    if (NODE_STATE(ksCurThread) == NODE_STATE(ksIdleThread) &&
+        pptr_to_paddr(vspace) == getCurrentUserVSpaceRoot()) {
+        setCurrentUserVSpaceRoot(kpptr_to_paddr(X86_GLOBAL_VSPACE_ROOT), 0);
+    }
+#endif
     invalidateLocalPCID(INVPCID_TYPE_SINGLE, (void *)0, asid);
 #ifdef ENABLE_SMP_SUPPORT
     if (pptr_to_paddr(vspace) != getCurrentUserVSpaceRoot()) {
@@ -38,3 +47,30 @@ static inline void invalidateASID(vspace_root_t *vspace, asid_t asid, word_t mas
     SMP_COND_STATEMENT(doRemoteInvalidateASID(vspace, asid, mask));
 }
 
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+static inline void invalidateLocalPCIDRange(vptr_t start, vptr_t end, word_t pageBits, asid_t asid)
+{
+    for (vptr_t vaddr = start; vaddr < end; vaddr += BIT(pageBits)) {
+        invalidateLocalPCID(INVPCID_TYPE_ADDR, (void *)vaddr, asid);
+    }
+}
+
+/*
+ * Invalidate the translations of the pages of size BIT(pageBits) in
+ * [start, end). Small ranges are invalidated one address at a time, which
+ * keeps the other TLB entries of the PCID but drops all of its
+ * paging-structure caches. Larger ones invalidate the whole PCID. Remote
+ * cores get a single IPI either way.
+ */
+static inline void invalidatePCIDRange(vspace_root_t *vspace, vptr_t start, vptr_t end, word_t pageBits,
+                                       asid_t asid, word_t mask)
+{
+    if (((end - start) >> pageBits) > CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD) {
+        invalidateASID(vspace, asid, mask);
+        return;
+    }
+    invalidateLocalPCIDRange(start, end, pageBits, asid);
+    SMP_COND_STATEMENT(doRemoteInvalidatePCIDRange(start, end, pageBits, asid, mask));
+}
+#endif
+
@@ -231,6 +231,9 @@ tagged_union cap capType {
     tag sched_context_cap   22
     tag sched_control_cap   24
 #endif
+#ifdef CONFIG_KERNEL_RING
+    tag ring_cap            26
+#endif
 
     -- 5-bit tag arch caps
     tag frame_cap           1
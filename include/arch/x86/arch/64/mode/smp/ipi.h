@@ -16,6 +16,9 @@
 typedef enum {
     IpiRemoteCall_InvalidatePCID = IpiNumArchRemoteCall,
     IpiRemoteCall_InvalidateASID,
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+    IpiRemoteCall_InvalidatePCIDRange,
+#endif
     IpiNumModeRemoteCall
 } IpiModeRemoteCall_t;
 
@@ -31,5 +34,13 @@ static inline void doRemoteInvalidateASID(vspace_root_t *vspace, asid_t asid, wo
     doRemoteMaskOp2Arg((IpiRemoteCall_t)IpiRemoteCall_InvalidateASID, (word_t)vspace, asid, mask);
 }
 
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+/* The page size bits travel in the low bits of the page aligned start address */
+static inline void doRemoteInvalidatePCIDRange(vptr_t start, vptr_t end, word_t pageBits, asid_t asid, word_t mask)
+{
+    doRemoteMaskOp3Arg((IpiRemoteCall_t)IpiRemoteCall_InvalidatePCIDRange, start | pageBits, end, asid, mask);
+}
+#endif
+
 #endif /* ENABLE_SMP_SUPPORT */
 
@@ -96,7 +96,11 @@ bool_t CONST isValidVTableRoot(cap_t cap);
 bool_t CONST isValidNativeRoot(cap_t cap);
 exception_t checkValidIPCBuffer(vptr_t vptr, cap_t cap);
 vm_rights_t CONST maskVMRights(vm_rights_t vm_rights, seL4_CapRights_t cap_rights_mask);
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+bool_t flushTable(vspace_root_t *vspace, word_t vptr, pte_t *pt, asid_t asid);
+#else
 void flushTable(vspace_root_t *vspace, word_t vptr, pte_t *pt, asid_t asid);
+#endif
 
 exception_t decodeX86MMUInvocation(word_t invLabel, word_t length, cptr_t cptr, cte_t *cte,
                                    cap_t cap, bool_t call, word_t *buffer);
@@ -111,6 +115,10 @@ exception_t decodeIA32PageDirectoryInvocation(word_t invLabel, word_t length, ct
 exception_t decodeX86FrameInvocation(word_t invLabel, word_t length, cte_t *cte, cap_t cap,
                                      bool_t call, word_t *buffer);
 
+#ifdef CONFIG_KERNEL_IPC_PAGE_GRANT
+word_t Arch_grantFrame(cte_t *slot, tcb_t *receiver, vptr_t vaddr, word_t size);
+#endif
+
 uint32_t CONST WritableFromVMRights(vm_rights_t vm_rights);
 uint32_t CONST SuperUserFromVMRights(vm_rights_t vm_rights);
 
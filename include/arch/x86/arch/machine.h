@@ -342,6 +342,13 @@ static inline void x86_load_fsgs_base(tcb_t *thread, cpu_id_t cpu)
 /* Cleaning memory before user-level access. Does not flush cache. */
 static inline void clearMemory(void *ptr, unsigned int bits)
 {
+#ifdef CONFIG_KERNEL_ARCH_CLEAR_MEMORY
+    if (x86KSclearMemoryRepStos) {
+        word_t n = BIT(bits);
+        asm volatile("rep stosb" : "+D"(ptr), "+c"(n) : "a"(0) : "memory");
+        return;
+    }
+#endif
     memzero(ptr, BIT(bits));
 }
 
@@ -68,6 +68,13 @@ extern x86_arch_global_state_t x86KSGlobalState[CONFIG_MAX_NUM_NODES] ALIGN(L1_C
 
 extern asid_pool_t *x86KSASIDTable[];
 extern uint32_t x86KScacheLineSizeBits;
+#ifdef CONFIG_KERNEL_ARCH_CLEAR_MEMORY
+extern bool_t x86KSclearMemoryRepStos;
+#endif
+#if defined(CONFIG_KERNEL_REVOKE_BATCH) && defined(ENABLE_SMP_SUPPORT)
+extern bool_t x86KSrevokeBatchActive;
+extern word_t x86KSrevokeBatchMask;
+#endif
 extern user_fpu_state_t x86KSnullFpuState ALIGN(MIN_FPU_ALIGNMENT);
 
 #ifdef CONFIG_IOMMU
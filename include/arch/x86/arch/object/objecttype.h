@@ -37,6 +37,24 @@ word_t Mode_getObjectSize(word_t t);
 
 void Arch_postCapDeletion(cap_t cap);
 
+#ifdef CONFIG_KERNEL_REVOKE_BATCH
+/* Bracket the deletions of a batched revoke, see cteRevokeBatch. On SMP the
+ * remote TLB shootdowns of frames unmapped in between are sent once at the
+ * end of the batch. */
+#ifdef ENABLE_SMP_SUPPORT
+void Arch_beginRevokeBatch(void);
+void Arch_endRevokeBatch(void);
+#else
+static inline void Arch_beginRevokeBatch(void)
+{
+}
+
+static inline void Arch_endRevokeBatch(void)
+{
+}
+#endif
+#endif
+
 /**
  * Return true if the given arch cap can be a descendant of an IRQControlCap.
  */
@@ -10,6 +10,7 @@
 #include <object/reply.h>
 #include <object/notification.h>
 #endif
+#include <kernel/lookupcache.h>
 
 #ifdef CONFIG_SIGNAL_FASTPATH
 /* Equivalent to schedContext_donate without migrateTCB() */
@@ -92,6 +93,9 @@ static inline cap_t FORCE_INLINE lookup_fp(cap_t cap, cptr_t cptr)
     cte_t *slot;
     word_t guardBits, radixBits, bits;
     word_t radix, capGuard;
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+    cap_t root = cap;
+#endif
 
     bits = 0;
 
@@ -99,6 +103,13 @@ static inline cap_t FORCE_INLINE lookup_fp(cap_t cap, cptr_t cptr)
         return cap_null_cap_new();
     }
 
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+    slot = lookupCacheGet(root, cptr);
+    if (likely(slot != NULL)) {
+        return slot->cap;
+    }
+#endif
+
     do {
         guardBits = cap_cnode_cap_get_capCNodeGuardSize(cap);
         radixBits = cap_cnode_cap_get_capCNodeRadix(cap);
@@ -128,6 +139,10 @@ static inline cap_t FORCE_INLINE lookup_fp(cap_t cap, cptr_t cptr)
         return cap_null_cap_new();
     }
 
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+    lookupCachePut(root, cptr, slot);
+#endif
+
     return cap;
 }
 /* make sure the fastpath functions conform with structure_*.bf */
@@ -22,12 +22,22 @@ typedef cte_t *slot_ptr_t;
 
 /* (node-local) state accessed only during bootstrapping */
 
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+/* the user image and the extra bootinfo */
+#define MAX_NUM_IT_LARGE_REG 2
+#endif
+
 typedef struct ndks_boot {
     p_region_t reserved[MAX_NUM_RESV_REG];
     word_t resv_count;
     region_t   freemem[MAX_NUM_FREEMEM_REG];
     seL4_BootInfo      *bi_frame;
     seL4_SlotPos slot_pos_cur;
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+    /* parts of the initial thread's address space mapped with large frames */
+    v_region_t it_large_reg[MAX_NUM_IT_LARGE_REG];
+    word_t it_large_count;
+#endif
 } ndks_boot_t;
 
 extern ndks_boot_t ndks_boot;
@@ -67,6 +77,9 @@ bool_t init_sched_control(cap_t root_cnode_cap, word_t num_nodes);
 
 typedef struct create_frames_of_region_ret {
     seL4_SlotRegion region;
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+    seL4_SlotRegion large; /* the caps in region that are large frames */
+#endif
     bool_t success;
 } create_frames_of_region_ret_t;
 
@@ -138,6 +151,12 @@ static inline BOOT_CODE pptr_t it_alloc_paging(void)
 /* return the amount of paging structures required to cover v_reg */
 word_t arch_get_n_paging(v_region_t it_veg);
 
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+void add_it_large_region(v_region_t v_reg, sword_t pv_offset);
+bool_t is_it_large_frame(vptr_t vptr);
+word_t get_n_it_large_frames(void);
+#endif
+
 #if defined(CONFIG_DEBUG_BUILD) && defined(ENABLE_SMP_SUPPORT) && defined(CONFIG_KERNEL_MCS) && !defined(CONFIG_PLAT_QEMU_ARM_VIRT)
 /* Test whether clocks are synchronised across nodes */
 #define ENABLE_SMP_CLOCK_SYNC_TEST_ON_BOOT
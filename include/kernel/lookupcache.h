@@ -0,0 +1,77 @@
+/*
+ * Copyright 2026, UNSW
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+
+#include <types.h>
+#include <util.h>
+#include <object/structures.h>
+#include <model/statedata.h>
+
+/* Full-depth lookups of a cptr in a CSpace only depend on the CNode caps
+ * along the path, so a cached slot stays correct until a CNode cap is
+ * written to or removed from some slot. Rather than tracking which entries
+ * a given slot affects, every such change advances a global generation,
+ * which invalidates the entries on all cores at once. */
+
+static inline lookup_cache_entry_t *lookupCacheEntry(cap_t root, cptr_t cptr)
+{
+    word_t index = (cptr ^ (cap_cnode_cap_get_capCNodePtr(root) >> seL4_SlotBits)) &
+                   MASK(LOOKUP_CACHE_BITS);
+    return &NODE_STATE(ksLookupCache)[index];
+}
+
+/* Returns the slot cached for cptr in the CSpace rooted at the CNode cap
+ * root, or NULL on a miss. */
+static inline cte_t *lookupCacheGet(cap_t root, cptr_t cptr)
+{
+    lookup_cache_entry_t *entry = lookupCacheEntry(root, cptr);
+
+    if (likely(entry->generation == ksLookupCacheGeneration &&
+               entry->cptr == cptr &&
+               entry->root.words[0] == root.words[0] &&
+               entry->root.words[1] == root.words[1])) {
+        return entry->slot;
+    }
+    return NULL;
+}
+
+static inline void lookupCachePut(cap_t root, cptr_t cptr, cte_t *slot)
+{
+    lookup_cache_entry_t *entry = lookupCacheEntry(root, cptr);
+
+    entry->root = root;
+    entry->cptr = cptr;
+    entry->slot = slot;
+    entry->generation = ksLookupCacheGeneration;
+}
+
+static inline void lookupCacheInvalidate(void)
+{
+    ksLookupCacheGeneration++;
+    if (unlikely(ksLookupCacheGeneration == 0)) {
+        /* The generation wrapped, so entries from the previous epoch could
+         * match again. Drop them all. */
+        for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+            memzero(NODE_STATE_ON_CORE(ksLookupCache, i), sizeof(NODE_STATE(ksLookupCache)));
+        }
+        ksLookupCacheGeneration = 1;
+    }
+}
+
+/* Called whenever cap is placed into or taken out of a slot. */
+static inline void lookupCacheCapUpdated(cap_t cap)
+{
+    if (cap_get_capType(cap) == cap_cnode_cap) {
+        lookupCacheInvalidate();
+    }
+}
+
+#endif /* CONFIG_KERNEL_LOOKUP_CACHE */
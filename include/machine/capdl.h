@@ -41,6 +41,9 @@ void obj_irq_print_maps(void);
 
 void cap_ep_print_attrs(cap_t ep);
 void cap_ntfn_print_attrs(cap_t ntfn);
+#ifdef CONFIG_KERNEL_RING
+void cap_ring_print_attrs(cap_t ring);
+#endif
 void cap_cnode_print_attrs(cap_t cnode);
 
 /* arch specific functions */
@@ -80,6 +80,9 @@ NODE_STATE_DECLARE(tcb_t *, ksCurFPUOwner);
 #ifdef CONFIG_DEBUG_BUILD
 NODE_STATE_DECLARE(tcb_t *, ksDebugTCBs);
 #endif /* CONFIG_DEBUG_BUILD */
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+NODE_STATE_DECLARE(lookup_cache_entry_t, ksLookupCache[BIT(LOOKUP_CACHE_BITS)]);
+#endif
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
 NODE_STATE_DECLARE(bool_t, benchmark_log_utilisation_enabled);
 NODE_STATE_DECLARE(timestamp_t, benchmark_start_time);
@@ -99,6 +102,9 @@ extern word_t ksNumCPUs;
 #define INT_STATE_ARRAY_SIZE (maxIRQ + 1)
 #endif
 extern word_t ksWorkUnitsCompleted;
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+extern word_t ksLookupCacheGeneration;
+#endif
 extern irq_state_t intStateIRQTable[];
 extern cte_t intStateIRQNode[];
 
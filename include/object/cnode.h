@@ -11,7 +11,7 @@
 #include <object/structures.h>
 
 exception_t decodeCNodeInvocation(word_t invLabel, word_t length,
-                                  cap_t cap, word_t *buffer);
+                                  cap_t cap, bool_t call, word_t *buffer);
 exception_t invokeCNodeRevoke(cte_t *destSlot);
 exception_t invokeCNodeDelete(cte_t *destSlot);
 exception_t invokeCNodeCancelBadgedSends(cap_t cap);
@@ -35,6 +35,15 @@ bool_t PURE slotCapLongRunningDelete(cte_t *slot);
 cte_t *getReceiveSlots(tcb_t *thread, word_t *buffer);
 cap_transfer_t PURE loadCapTransfer(word_t *buffer);
 
+#ifdef CONFIG_KERNEL_CNODE_BATCH
+exception_t invokeCNodeBatch(cte_t *destRootSlot, cte_t *srcRootSlot, word_t numEntries,
+                             bool_t call, word_t *buffer);
+#endif
+#ifdef CONFIG_KERNEL_MDB_STATS
+exception_t invokeCNodeMDBStats(cte_t *slot, bool_t call);
+void mdbStatsThreadDeleted(tcb_t *thread);
+#endif
+
 #ifndef CONFIG_KERNEL_MCS
 exception_t invokeCNodeSaveCaller(cte_t *destSlot);
 void setupReplyMaster(tcb_t *thread);
@@ -0,0 +1,21 @@
+/*
+ * Copyright 2026, UNSW
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+
+#ifdef CONFIG_KERNEL_RING
+
+#include <types.h>
+#include <api/failures.h>
+#include <object/structures.h>
+
+exception_t decodeRingInvocation(word_t invLabel, cptr_t capIndex, cap_t cap);
+void receiveRing(tcb_t *thread, ring_t *ring, bool_t isBlocking);
+void finaliseRing(ring_t *ring);
+
+#endif /* CONFIG_KERNEL_RING */
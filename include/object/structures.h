@@ -103,6 +103,11 @@ typedef word_t notification_state_t;
 #define REPLY_REF(p) ((word_t) (p))
 #define REPLY_PTR(r) ((reply_t *) (r))
 
+#ifdef CONFIG_KERNEL_RING
+#define RING_REF(p) ((word_t) (p))
+#define RING_PTR(r) ((ring_t *) (r))
+#endif
+
 #define WORD_PTR(r) ((word_t *)(r))
 #define WORD_REF(p) ((word_t)(p))
 
@@ -242,65 +247,92 @@ typedef struct sched_context sched_context_t;
 typedef struct reply reply_t;
 #endif
 
+#ifdef CONFIG_KERNEL_COMPACT_TCB_LINKS
+/* A compact TCB link is the signed distance from the TCB holding the link to
+ * the TCB it refers to, in units of BIT(seL4_TCBBits). TCBs lie at the same
+ * offset in objects aligned to that size, so the distance is exact, and as a
+ * TCB is never linked to itself 0 can stand for NULL. 32 bits cover every
+ * kernel window on 64-bit kernels. */
+typedef int32_t tcb_link_t;
+#else
+typedef struct tcb *tcb_link_t;
+#endif
+
 struct tcb {
     /* arch specific tcb state (including context)*/
     arch_tcb_t tcbArch;
 
+    /* The fields up to tcbFault are read or written on every pass through the
+     * fastpath, the scheduler and the endpoint queues, and are kept together
+     * directly after the register context so that they occupy at most two
+     * cache lines (checked below). Fields after tcbFault are only used by the
+     * slowpath. */
+
     /* Thread state, 3 words */
     thread_state_t tcbState;
 
-    /* Currently only used for seL4_TCBFlag_fpuDisabled */
-    word_t tcbFlags; /* seL4_TCBFlag */
+    /* Priority, 1 byte (padded to 1 word) */
+    prio_t tcbPriority;
+
+    /* Domain, 1 byte (padded to 1 word) */
+    dom_t tcbDomain;
+
+#ifdef ENABLE_SMP_SUPPORT
+    /* cpu ID this thread is running on, 1 word */
+    word_t tcbAffinity;
+#endif /* ENABLE_SMP_SUPPORT */
+
+    /* Previous and next links for scheduler queues, 2 words (1 word with
+     * KernelCompactTCBLinks). Accessed with tcb_ptr_get/set_tcbSchedNext etc. */
+    tcb_link_t tcbSchedNext;
+    tcb_link_t tcbSchedPrev;
+    /* Previous and next links for endpoint and notification queues, 2 words
+     * (1 word with KernelCompactTCBLinks) */
+    tcb_link_t tcbEPNext;
+    tcb_link_t tcbEPPrev;
+
+#ifdef CONFIG_KERNEL_MCS
+    /* scheduling context that this tcb is running on, if it is NULL the tcb cannot
+     * be in the scheduler queues, 1 word */
+    sched_context_t *tcbSchedContext;
+#else
+    /* Timeslice remaining, 1 word */
+    word_t tcbTimeSlice;
+
+    /* Capability pointer to thread fault handler, 1 word */
+    cptr_t tcbFaultHandler;
+#endif
 
     /* Notification that this TCB is bound to. If this is set, when this TCB waits on
      * any sync endpoint, it may receive a signal from a Notification object.
      * 1 word*/
     notification_t *tcbBoundNotification;
 
+    /* Currently only used for seL4_TCBFlag_fpuDisabled */
+    word_t tcbFlags; /* seL4_TCBFlag */
+
     /* Current fault, 2 words */
     seL4_Fault_t tcbFault;
 
     /* Current lookup failure, 2 words */
     lookup_fault_t tcbLookupFailure;
 
-    /* Domain, 1 byte (padded to 1 word) */
-    dom_t tcbDomain;
-
     /*  maximum controlled priority, 1 byte (padded to 1 word) */
     prio_t tcbMCP;
 
-    /* Priority, 1 byte (padded to 1 word) */
-    prio_t tcbPriority;
-
 #ifdef CONFIG_KERNEL_MCS
-    /* scheduling context that this tcb is running on, if it is NULL the tcb cannot
-     * be in the scheduler queues, 1 word */
-    sched_context_t *tcbSchedContext;
-
     /* scheduling context that this tcb yielded to */
     sched_context_t *tcbYieldTo;
-#else
-    /* Timeslice remaining, 1 word */
-    word_t tcbTimeSlice;
-
-    /* Capability pointer to thread fault handler, 1 word */
-    cptr_t tcbFaultHandler;
 #endif
 
     /* userland virtual address of thread IPC buffer, 1 word */
     word_t tcbIPCBuffer;
 
-#ifdef ENABLE_SMP_SUPPORT
-    /* cpu ID this thread is running on, 1 word */
-    word_t tcbAffinity;
-#endif /* ENABLE_SMP_SUPPORT */
-
-    /* Previous and next pointers for scheduler queues , 2 words */
-    struct tcb *tcbSchedNext;
-    struct tcb *tcbSchedPrev;
-    /* Previous and next pointers for endpoint and notification queues, 2 words */
-    struct tcb *tcbEPNext;
-    struct tcb *tcbEPPrev;
+#ifdef CONFIG_KERNEL_IPC_PAGE_GRANT
+    /* window that granted frames are mapped into, 2 words */
+    word_t tcbGrantWindowBase;
+    word_t tcbGrantWindowSize;
+#endif
 
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
     /* 16 bytes (12 bytes aarch32) */
@@ -309,6 +341,49 @@ struct tcb {
 };
 typedef struct tcb tcb_t;
 
+static inline tcb_link_t tcb_link_from_ptr(tcb_t *tcb, tcb_t *target)
+{
+#ifdef CONFIG_KERNEL_COMPACT_TCB_LINKS
+    sword_t distance;
+
+    if (target == NULL) {
+        return 0;
+    }
+    distance = ((sword_t)target - (sword_t)tcb) / (sword_t)BIT(seL4_TCBBits);
+    assert(distance != 0 && distance == (tcb_link_t)distance);
+    return (tcb_link_t)distance;
+#else
+    return target;
+#endif
+}
+
+static inline tcb_t *CONST tcb_link_to_ptr(tcb_t *tcb, tcb_link_t link)
+{
+#ifdef CONFIG_KERNEL_COMPACT_TCB_LINKS
+    if (link == 0) {
+        return NULL;
+    }
+    return (tcb_t *)((word_t)tcb + (word_t)((sword_t)link * (sword_t)BIT(seL4_TCBBits)));
+#else
+    return link;
+#endif
+}
+
+#define TCB_LINK_ACCESSORS(field)                                            \
+static inline tcb_t *PURE tcb_ptr_get_##field(tcb_t *tcb)                    \
+{                                                                            \
+    return tcb_link_to_ptr(tcb, tcb->field);                                 \
+}                                                                            \
+static inline void tcb_ptr_set_##field(tcb_t *tcb, tcb_t *v)                 \
+{                                                                            \
+    tcb->field = tcb_link_from_ptr(tcb, v);                                  \
+}
+
+TCB_LINK_ACCESSORS(tcbSchedNext)
+TCB_LINK_ACCESSORS(tcbSchedPrev)
+TCB_LINK_ACCESSORS(tcbEPNext)
+TCB_LINK_ACCESSORS(tcbEPPrev)
+
 #ifdef CONFIG_DEBUG_BUILD
 /* This debug_tcb object is inserted into the 'unused' region of a TCB object
    for debug build configurations. */
@@ -400,6 +475,30 @@ struct reply {
 };
 #endif
 
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+/* Result of a full-depth lookup of cptr in the CSpace rooted at root. The
+ * entry is only valid while generation equals ksLookupCacheGeneration. */
+struct lookup_cache_entry {
+    cap_t root;
+    cptr_t cptr;
+    cte_t *slot;
+    word_t generation;
+};
+typedef struct lookup_cache_entry lookup_cache_entry_t;
+
+#define LOOKUP_CACHE_BITS 4
+#endif
+
+#ifdef CONFIG_KERNEL_RING
+/* A ring is a notification together with a slot holding the frame cap
+ * whose first bytes contain the seL4_RingHeader shared with user level. */
+struct ring {
+    notification_t ringNtfn;
+    cte_t ringBuffer;
+};
+typedef struct ring ring_t;
+#endif
+
 /* Ensure object sizes are sane */
 compile_assert(cte_size_sane, sizeof(cte_t) == BIT(seL4_SlotBits))
 compile_assert(tcb_cte_size_sane, TCB_CNODE_SIZE_BITS <= TCB_SIZE_BITS)
@@ -407,9 +506,15 @@ compile_assert(tcb_size_sane,
                BIT(TCB_SIZE_BITS) >= sizeof(tcb_t))
 compile_assert(tcb_size_not_excessive,
                BIT(TCB_SIZE_BITS - 1) < sizeof(tcb_t))
+compile_assert(tcb_hot_fields_fit,
+               OFFSETOF(tcb_t, tcbLookupFailure) - OFFSETOF(tcb_t, tcbState) <= 2 * L1_CACHE_LINE_SIZE)
 compile_assert(ep_size_sane, sizeof(endpoint_t) == BIT(seL4_EndpointBits))
 compile_assert(notification_size_sane, sizeof(notification_t) == BIT(seL4_NotificationBits))
 
+#ifdef CONFIG_KERNEL_RING
+compile_assert(ring_size_sane, sizeof(ring_t) <= BIT(seL4_RingBits))
+#endif
+
 /* Check the IPC buffer is the right size */
 compile_assert(ipc_buf_size_sane, sizeof(seL4_IPCBuffer) == BIT(seL4_IPCBufferSizeBits))
 #ifdef CONFIG_KERNEL_MCS
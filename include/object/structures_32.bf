@@ -125,6 +125,18 @@ block domain_cap {
     field capType 8
 }
 
+#ifdef CONFIG_KERNEL_RING
+block ring_cap {
+    field_high capRingPtr 27
+    padding 3
+    field capRingCanReceive 1
+    field capRingCanSend 1
+
+    field capRingBadge 24
+    field capType 8
+}
+#endif
+
 #ifdef CONFIG_KERNEL_MCS
 block sched_context_cap {
     field_high capSCPtr 28
@@ -173,6 +173,25 @@ block domain_cap {
     padding 59
 }
 
+#ifdef CONFIG_KERNEL_RING
+block ring_cap {
+    field capRingBadge 64
+
+    field capType 5
+    field capRingCanReceive 1
+    field capRingCanSend 1
+#if BF_CANONICAL_RANGE == 48
+    padding 9
+    field_high capRingPtr 48
+#elif BF_CANONICAL_RANGE == 39
+    padding 18
+    field_high capRingPtr 39
+#else
+#error "Unspecified canonical address range"
+#endif
+}
+#endif
+
 #ifdef CONFIG_KERNEL_MCS
 block sched_context_cap {
 #if BF_CANONICAL_RANGE == 48
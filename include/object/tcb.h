@@ -56,8 +56,8 @@ static inline tcb_queue_t tcb_queue_prepend(tcb_queue_t queue, tcb_t *tcb)
     if (tcb_queue_empty(queue)) {
         queue.end = tcb;
     } else {
-        tcb->tcbSchedNext = queue.head;
-        queue.head->tcbSchedPrev = tcb;
+        tcb_ptr_set_tcbSchedNext(tcb, queue.head);
+        tcb_ptr_set_tcbSchedPrev(queue.head, tcb);
     }
 
     queue.head = tcb;
@@ -70,8 +70,8 @@ static inline tcb_queue_t tcb_queue_append(tcb_queue_t queue, tcb_t *tcb)
     if (tcb_queue_empty(queue)) {
         queue.head = tcb;
     } else {
-        tcb->tcbSchedPrev = queue.end;
-        queue.end->tcbSchedNext = tcb;
+        tcb_ptr_set_tcbSchedPrev(tcb, queue.end);
+        tcb_ptr_set_tcbSchedNext(queue.end, tcb);
     }
 
     queue.end = tcb;
@@ -84,16 +84,16 @@ static inline tcb_queue_t tcb_queue_append(tcb_queue_t queue, tcb_t *tcb)
 static inline void tcb_queue_insert(tcb_t *tcb, tcb_t *after)
 {
     tcb_t *before;
-    before = after->tcbSchedPrev;
+    before = tcb_ptr_get_tcbSchedPrev(after);
 
     assert(before != NULL);
     assert(before != after);
 
-    tcb->tcbSchedPrev = before;
-    tcb->tcbSchedNext = after;
+    tcb_ptr_set_tcbSchedPrev(tcb, before);
+    tcb_ptr_set_tcbSchedNext(tcb, after);
 
-    after->tcbSchedPrev = tcb;
-    before->tcbSchedNext = tcb;
+    tcb_ptr_set_tcbSchedPrev(after, tcb);
+    tcb_ptr_set_tcbSchedNext(before, tcb);
 }
 
 #ifdef CONFIG_DEBUG_BUILD
@@ -138,25 +138,25 @@ static inline tcb_queue_t tcbEPAppend(tcb_t *tcb, tcb_queue_t queue)
     /* find a place to put the tcb */
     while (unlikely(before != NULL && tcb->tcbPriority > before->tcbPriority)) {
         after = before;
-        before = after->tcbEPPrev;
+        before = tcb_ptr_get_tcbEPPrev(after);
     }
 
     if (unlikely(before == NULL)) {
         /* insert at head */
         queue.head = tcb;
     } else {
-        before->tcbEPNext = tcb;
+        tcb_ptr_set_tcbEPNext(before, tcb);
     }
 
     if (likely(after == NULL)) {
         /* insert at tail */
         queue.end = tcb;
     } else {
-        after->tcbEPPrev = tcb;
+        tcb_ptr_set_tcbEPPrev(after, tcb);
     }
 
-    tcb->tcbEPNext = after;
-    tcb->tcbEPPrev = before;
+    tcb_ptr_set_tcbEPNext(tcb, after);
+    tcb_ptr_set_tcbEPPrev(tcb, before);
 
     return queue;
 }
@@ -255,6 +255,15 @@ exception_t invokeTCB_CopyRegisters(tcb_t *dest, tcb_t *src,
                                     word_t transferArch);
 exception_t invokeTCB_ReadRegisters(tcb_t *src, bool_t suspendSource,
                                     word_t n, word_t arch, bool_t call);
+#ifdef CONFIG_KERNEL_TCB_SPAWN
+exception_t decodeTCBSpawn(cap_t cap, word_t length, cte_t *slot, word_t *buffer);
+exception_t invokeTCB_Spawn(tcb_t *target, cte_t *slot, cptr_t faultep,
+                            prio_t mcp, prio_t priority,
+                            cap_t cRoot_newCap, cte_t *cRoot_srcSlot,
+                            cap_t vRoot_newCap, cte_t *vRoot_srcSlot,
+                            word_t bufferAddr, cap_t bufferCap, cte_t *bufferSrcSlot,
+                            word_t affinity, word_t n, word_t *buffer);
+#endif
 exception_t invokeTCB_WriteRegisters(tcb_t *dest, bool_t resumeTarget,
                                      word_t n, word_t arch, word_t *buffer);
 exception_t invokeTCB_NotificationControl(tcb_t *tcb, notification_t *ntfnPtr);
@@ -34,3 +34,20 @@ exception_t invokeUntyped_Retype(cte_t *srcSlot, bool_t reset,
                                  void *retypeBase, object_t newType, word_t userSize,
                                  cte_t *destCNode, word_t destOffset, word_t destLength,
                                  bool_t deviceMemory);
+#ifdef CONFIG_KERNEL_UNTYPED_RECLAIM
+exception_t invokeUntyped_Reclaim(cte_t *srcSlot);
+void untypedReclaimCapInserted(cte_t *parent, cap_t cap);
+void untypedReclaimSlotMoved(cte_t *srcSlot, cte_t *destSlot);
+void untypedReclaimSlotsSwapped(cte_t *slot1, cte_t *slot2);
+void untypedReclaimSlotRemoved(cte_t *slot, cte_t *prev);
+void untypedReclaimThreadDeleted(tcb_t *thread);
+#endif
+#ifdef CONFIG_KERNEL_RETYPE_BATCH
+exception_t decodeUntypedRetypeBatch(word_t length, cte_t *slot, cap_t cap, word_t *buffer);
+exception_t invokeUntyped_RetypeBatch(cte_t *srcSlot, bool_t reset, cte_t *destCNode,
+                                      word_t numEntries, bool_t deviceMemory);
+#endif
+#ifdef CONFIG_KERNEL_LAZY_UNTYPED_ZERO
+exception_t decodeUntypedClearFree(cte_t *slot, cap_t cap);
+exception_t invokeUntyped_ClearFree(cte_t *srcSlot, bool_t reset);
+#endif
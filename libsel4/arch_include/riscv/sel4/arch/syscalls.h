@@ -987,3 +987,12 @@ LIBSEL4_INLINE_FUNC void seL4_SetTLSBase(seL4_Word tls_base)
     asm volatile("" ::: "memory");
 }
 #endif /* CONFIG_SET_TLS_BASE_SELF */
+
+#ifdef CONFIG_KERNEL_SIGNAL_BATCH
+LIBSEL4_INLINE_FUNC void seL4_SignalBatch(seL4_Word count)
+{
+    /* The notification cptrs are read from the IPC buffer */
+    asm volatile("" ::: "memory");
+    riscv_sys_send_null(seL4_SysSignalBatch, count, 0);
+}
+#endif /* CONFIG_KERNEL_SIGNAL_BATCH */
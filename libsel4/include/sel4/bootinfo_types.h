@@ -70,6 +70,10 @@ typedef struct seL4_BootInfo {
     seL4_Domain       initThreadDomain; /* Initial thread's domain ID */
 #ifdef CONFIG_KERNEL_MCS
     seL4_SlotRegion   schedcontrol; /* Caps to sched_control for each node */
+#endif
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+    seL4_SlotRegion   userImageLargeFrames; /* the caps in userImageFrames that are large frames */
+    seL4_SlotRegion   extraBILargePages;    /* the caps in extraBIPages that are large frames */
 #endif
     seL4_SlotRegion   untyped;         /* untyped-object caps (untyped caps) */
     seL4_UntypedDesc  untypedList[CONFIG_MAX_NUM_BOOTINFO_UNTYPED_CAPS]; /* information about each untyped */
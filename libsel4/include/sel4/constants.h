@@ -57,6 +57,76 @@ enum seL4_MsgLimits {
 
 #define seL4_MsgMaxExtraCaps (LIBSEL4_BIT(seL4_MsgExtraCapBits)-1)
 
+#ifdef CONFIG_KERNEL_BULK_CAP_TRANSFER
+/* Position of the receive window size in the receiveDepth field of the IPC
+ * buffer, see seL4_SetCapReceiveWindow */
+#define seL4_CapReceiveWindowShift 8
+/* Top bit of the label of a sent message tag, which requests a bulk capability
+ * transfer of the caps named by the message registers. It is cleared in the
+ * message tag the receiver gets. */
+#define seL4_MsgBulkCapsLabel LIBSEL4_BIT(seL4_WordBits - 13)
+#endif
+
+#ifdef CONFIG_KERNEL_CNODE_BATCH
+/* Layout of the entries of seL4_CNode_Batch in the message registers, see
+ * seL4_SetCNodeBatchEntry. The first word of an entry packs the operation,
+ * both depths and the rights, and is replaced by seL4_CNodeBatch_Done and the
+ * seL4_Error of the operation once it has been applied. */
+#define seL4_CNodeBatchFirstMR 4
+#define seL4_CNodeBatchEntryWords 4
+#define seL4_CNodeBatchMaxEntries \
+    ((seL4_MsgMaxLength - seL4_CNodeBatchFirstMR) / seL4_CNodeBatchEntryWords)
+#define seL4_CNodeBatchDestDepthShift 8
+#define seL4_CNodeBatchSrcDepthShift 16
+#define seL4_CNodeBatchRightsShift 24
+#define seL4_CNodeBatchStatusShift 8
+
+enum seL4_CNodeBatchOp {
+    seL4_CNodeBatch_Copy = 1,
+    seL4_CNodeBatch_Mint,
+    seL4_CNodeBatch_Move,
+    seL4_CNodeBatch_Delete,
+    seL4_CNodeBatch_Done = 0x80
+};
+#endif
+
+#ifdef CONFIG_KERNEL_MDB_STATS
+/* Shape of the seL4_MDBStats reply of seL4_CNode_MDBStats */
+#define seL4_MDBStatsFanoutBuckets 16
+#define seL4_MDBStatsMaxDepth 32
+
+/* Capability classes counted by seL4_CNode_MDBStats */
+enum seL4_MDBStatsType {
+    seL4_MDBStats_Untyped,
+    seL4_MDBStats_Endpoint,
+    seL4_MDBStats_Notification,
+    seL4_MDBStats_Reply,
+    seL4_MDBStats_CNode,
+    seL4_MDBStats_TCB,
+    seL4_MDBStats_IRQHandler,
+    seL4_MDBStats_Zombie,
+    seL4_MDBStats_SchedContext,
+    seL4_MDBStats_Frame,
+    seL4_MDBStats_Arch,
+    seL4_MDBStats_Other,
+    seL4_MDBStatsTypeCount
+};
+#endif
+
+#ifdef CONFIG_KERNEL_RETYPE_BATCH
+/* Layout of the entries of seL4_Untyped_RetypeBatch in the message registers,
+ * see seL4_SetRetypeBatchEntry */
+#define seL4_RetypeBatchFirstMR 4
+#define seL4_RetypeBatchEntryWords 4
+#define seL4_RetypeBatchMaxEntries \
+    ((seL4_MsgMaxLength - seL4_RetypeBatchFirstMR) / seL4_RetypeBatchEntryWords)
+/* Message length of a batch of n entries. Out of range batches are sent
+ * without their entries, and are rejected by the kernel. */
+#define seL4_RetypeBatchMsgLength(n) \
+    ((n) <= seL4_RetypeBatchMaxEntries ? \
+     seL4_RetypeBatchFirstMR + (n) * seL4_RetypeBatchEntryWords : seL4_RetypeBatchFirstMR)
+#endif
+
 /* seL4_CapRights_t defined in shared_types_*.bf */
 #define seL4_CapRightsBits 4
 
@@ -73,12 +143,16 @@ typedef enum {
 typedef enum {
     seL4_TCBFlag_NoFlag = 0x0,
     seL4_TCBFlag_fpuDisabled = 0x1,
+    seL4_TCBFlag_grantFrames = 0x2,
 
     SEL4_FORCE_LONG_ENUM(seL4_TCBFlag),
     seL4_TCBFlag_MASK = seL4_TCBFlag_NoFlag
 #ifdef CONFIG_HAVE_FPU
                         | seL4_TCBFlag_fpuDisabled
 #endif
+#ifdef CONFIG_KERNEL_IPC_PAGE_GRANT
+                        | seL4_TCBFlag_grantFrames
+#endif
 } seL4_TCBFlag;
 
 #endif /* !__ASSEMBLER__ */
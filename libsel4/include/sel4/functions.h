@@ -103,3 +103,82 @@ LIBSEL4_INLINE_FUNC void seL4_SetCapReceivePath(seL4_CPtr receiveCNode, seL4_CPt
     ipcbuffer->receiveDepth = receiveDepth;
 }
 
+#ifdef CONFIG_KERNEL_BULK_CAP_TRANSFER
+/* Nominate count consecutive receive slots, starting at receiveIndex, for a
+ * bulk capability transfer. A count of zero or one receives a single cap. */
+LIBSEL4_INLINE_FUNC void seL4_SetCapReceiveWindow(seL4_CPtr receiveCNode, seL4_CPtr receiveIndex,
+                                                  seL4_Word receiveDepth, seL4_Word count)
+{
+    seL4_SetCapReceivePath(receiveCNode, receiveIndex,
+                           receiveDepth | (count << seL4_CapReceiveWindowShift));
+}
+
+/* Message tag for a bulk capability transfer of the caps named by the first
+ * count message registers. The top bit of the label is not delivered. */
+LIBSEL4_INLINE_FUNC seL4_MessageInfo_t seL4_BulkCapsMessageInfo_new(seL4_Word label, seL4_Word count)
+{
+    return seL4_MessageInfo_new(label | seL4_MsgBulkCapsLabel, 0, 0, count);
+}
+#endif
+
+#ifdef CONFIG_KERNEL_CNODE_BATCH
+/* Fill in entry i of the next seL4_CNode_Batch invocation. The destination is
+ * resolved from the invoked CNode and the source from the src_root argument;
+ * rights apply to copy and mint, and badge to mint only. */
+LIBSEL4_INLINE_FUNC void seL4_SetCNodeBatchEntry(seL4_Word i, seL4_Word op,
+                                                 seL4_Word dest_index, seL4_Uint8 dest_depth,
+                                                 seL4_Word src_index, seL4_Uint8 src_depth,
+                                                 seL4_CapRights_t rights, seL4_Word badge)
+{
+    seL4_Word mr = seL4_CNodeBatchFirstMR + i * seL4_CNodeBatchEntryWords;
+
+    seL4_SetMR(mr, op | ((seL4_Word)dest_depth << seL4_CNodeBatchDestDepthShift)
+               | ((seL4_Word)src_depth << seL4_CNodeBatchSrcDepthShift)
+               | (rights.words[0] << seL4_CNodeBatchRightsShift));
+    seL4_SetMR(mr + 1, dest_index);
+    seL4_SetMR(mr + 2, src_index);
+    seL4_SetMR(mr + 3, badge);
+}
+
+/* Outcome of entry i of the last seL4_CNode_Batch invocation, or -1 if the
+ * entry was not applied. */
+LIBSEL4_INLINE_FUNC int seL4_GetCNodeBatchStatus(seL4_Word i)
+{
+    seL4_Word word = seL4_GetMR(seL4_CNodeBatchFirstMR + i * seL4_CNodeBatchEntryWords);
+
+    if (!(word & seL4_CNodeBatch_Done)) {
+        return -1;
+    }
+    return (int)(word >> seL4_CNodeBatchStatusShift);
+}
+#endif
+
+#ifdef CONFIG_KERNEL_RETYPE_BATCH
+/* Fill in entry i of the next seL4_Untyped_RetypeBatch invocation. Entries
+ * live above the invocation arguments in the IPC buffer. */
+LIBSEL4_INLINE_FUNC void seL4_SetRetypeBatchEntry(seL4_Word i, seL4_Word type, seL4_Word size_bits,
+                                                  seL4_Word node_offset, seL4_Word num_objects)
+{
+    seL4_Word mr = seL4_RetypeBatchFirstMR + i * seL4_RetypeBatchEntryWords;
+
+    seL4_SetMR(mr, type);
+    seL4_SetMR(mr + 1, size_bits);
+    seL4_SetMR(mr + 2, node_offset);
+    seL4_SetMR(mr + 3, num_objects);
+}
+#endif
+
+#ifdef CONFIG_ARM_CACHE_FLUSH_BATCH
+/* Fill in entry i of the next seL4_ARM_VSpace_FlushBatch invocation, which
+ * applies op to the size bytes starting at vaddr. The range must not cross
+ * a page boundary. */
+LIBSEL4_INLINE_FUNC void seL4_ARM_SetFlushBatchEntry(seL4_Word i, seL4_ARM_FlushBatchOp op,
+                                                     seL4_Word vaddr, seL4_Word size)
+{
+    seL4_Word mr = seL4_ARM_FlushBatchFirstMR + i * seL4_ARM_FlushBatchEntryWords;
+
+    seL4_SetMR(mr, vaddr);
+    seL4_SetMR(mr + 1, (size << seL4_ARM_FlushBatchOpBits) | op);
+}
+#endif
+
@@ -14,6 +14,9 @@ typedef enum api_object {
 #ifdef CONFIG_KERNEL_MCS
     seL4_SchedContextObject,
     seL4_ReplyObject,
+#endif
+#ifdef CONFIG_KERNEL_RING
+    seL4_RingObject,
 #endif
     seL4_NonArchObjectTypeCount,
 } seL4_ObjectType;
@@ -40,3 +40,12 @@ typedef enum {
 #define seL4_NoRead        seL4_CapRights_new(1, 1, 0, 1)
 #define seL4_NoRights      seL4_CapRights_new(0, 0, 0, 0)
 
+
+/* Header at the start of the frame bound to a ring object. The producer
+ * advances tail, the consumer advances head, and the kernel sets waiting
+ * while the consumer is blocked on the ring with no records pending. */
+typedef struct seL4_RingHeader {
+    seL4_Word head;
+    seL4_Word tail;
+    seL4_Word waiting;
+} seL4_RingHeader;
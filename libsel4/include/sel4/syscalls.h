@@ -390,3 +390,22 @@ LIBSEL4_INLINE_FUNC void
 seL4_SetTLSBase(seL4_Word tls_base);
 #endif
 
+#ifdef CONFIG_KERNEL_SIGNAL_BATCH
+/**
+ * @xmlonly <manual name="Signal Batch" label="sel4_signalbatch"/> @endxmlonly
+ * @brief Signal several notifications in a single system call.
+ *
+ * The capability addresses of the notifications are taken from message
+ * registers 0 to count - 1, which must be set with seL4_SetMR() before
+ * the call. Each notification is signalled as by seL4_Signal(), using the
+ * badge of its capability. Entries that do not refer to a notification
+ * capability with the Write right are ignored.
+ *
+ * The kernel reschedules once, after all notifications have been signalled.
+ *
+ * @param count The number of notifications to signal, at most seL4_MsgMaxLength.
+ */
+LIBSEL4_INLINE_FUNC void
+seL4_SignalBatch(seL4_Word count);
+#endif
+
@@ -40,9 +40,27 @@ typedef seL4_CPtr seL4_Untyped;
 typedef seL4_CPtr seL4_DomainSet;
 typedef seL4_CPtr seL4_SchedContext;
 typedef seL4_CPtr seL4_SchedControl;
+typedef seL4_CPtr seL4_Ring;
 
 typedef seL4_Uint64 seL4_Time;
 
+#ifdef CONFIG_KERNEL_MDB_STATS
+/* Result of seL4_CNode_MDBStats. The depth of a slot is its distance from the
+ * inspected slot, and fanout[i] counts the slots with no children for i = 0,
+ * and with between 2^(i-1) and 2^i - 1 children otherwise, the last bucket
+ * being open ended. Slots deeper than seL4_MDBStatsMaxDepth are counted in
+ * deep_nodes and treated as children of their ancestor at that depth. */
+typedef struct seL4_MDBStats {
+    seL4_Word descendants;
+    seL4_Word children;
+    seL4_Word max_depth;
+    seL4_Word max_fanout;
+    seL4_Word deep_nodes;
+    seL4_Word fanout[seL4_MDBStatsFanoutBuckets];
+    seL4_Word types[seL4_MDBStatsTypeCount];
+} seL4_MDBStats;
+#endif
+
 #define seL4_NilData 0
 
 #include <sel4/arch/constants.h>
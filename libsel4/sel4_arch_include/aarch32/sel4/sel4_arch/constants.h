@@ -183,9 +183,11 @@ typedef enum {
 #define seL4_EndpointBits 4
 #ifdef CONFIG_KERNEL_MCS
 #define seL4_NotificationBits 5
+#define seL4_RingBits         6
 #define seL4_ReplyBits 4
 #else
 #define seL4_NotificationBits 4
+#define seL4_RingBits         5
 #endif
 
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
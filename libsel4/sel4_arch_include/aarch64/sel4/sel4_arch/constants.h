@@ -161,6 +161,27 @@ typedef enum {
     SEL4_FORCE_LONG_ENUM(seL4_Timeout_Msg)
 } seL4_Timeout_Msg;
 #endif
+
+#ifdef CONFIG_ARM_CACHE_FLUSH_BATCH
+/* Layout of the entries of seL4_ARM_VSpace_FlushBatch in the message
+ * registers, see seL4_ARM_SetFlushBatchEntry. The entries start after the
+ * registers that the invocation stub passes arguments in. The first word of
+ * an entry is the start address and the second packs the size with the
+ * operation. */
+#define seL4_ARM_FlushBatchFirstMR seL4_FastMessageRegisters
+#define seL4_ARM_FlushBatchEntryWords 2
+#define seL4_ARM_FlushBatchMaxEntries \
+    ((seL4_MsgMaxLength - seL4_ARM_FlushBatchFirstMR) / seL4_ARM_FlushBatchEntryWords)
+#define seL4_ARM_FlushBatchOpBits 2
+
+typedef enum {
+    seL4_ARM_FlushBatch_Clean,
+    seL4_ARM_FlushBatch_Invalidate,
+    seL4_ARM_FlushBatch_CleanInvalidate,
+    seL4_ARM_FlushBatch_Unify,
+    SEL4_FORCE_LONG_ENUM(seL4_ARM_FlushBatchOp)
+} seL4_ARM_FlushBatchOp;
+#endif
 #endif /* !__ASSEMBLER__ */
 
 #define seL4_DataFault 0
@@ -178,9 +199,11 @@ typedef enum {
 #define seL4_EndpointBits 4
 #ifdef CONFIG_KERNEL_MCS
 #define seL4_NotificationBits 6
+#define seL4_RingBits         7
 #define seL4_ReplyBits           5
 #else
 #define seL4_NotificationBits 5
+#define seL4_RingBits         6
 #endif
 
 #define seL4_PageTableBits 12
@@ -24,9 +24,11 @@
 #define seL4_EndpointBits     4
 #ifdef CONFIG_KERNEL_MCS
 #define seL4_NotificationBits 5
+#define seL4_RingBits         6
 #define seL4_ReplyBits        4
 #else
 #define seL4_NotificationBits 4
+#define seL4_RingBits         5
 #endif
 
 #define seL4_PageTableBits   12
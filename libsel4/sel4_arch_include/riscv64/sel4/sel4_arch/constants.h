@@ -17,9 +17,11 @@
 #define seL4_SlotBits           5
 #ifdef CONFIG_KERNEL_MCS
 #define seL4_NotificationBits   6
+#define seL4_RingBits           7
 #define seL4_ReplyBits          5
 #else
 #define seL4_NotificationBits   5
+#define seL4_RingBits           6
 #endif
 #define seL4_EndpointBits       4
 #define seL4_IPCBufferSizeBits  10
@@ -37,6 +39,7 @@
 #define seL4_LargePageBits     21
 #define seL4_HugePageBits      30
 #define seL4_TeraPageBits      39
+#define seL4_NapotPageBits     16
 #define seL4_PageTableBits     12
 #define seL4_VSpaceBits        seL4_PageTableBits
 
@@ -13,6 +13,9 @@ typedef enum _mode_object {
     seL4_RISCV_Giga_Page = seL4_NonArchObjectTypeCount,
 #if CONFIG_PT_LEVELS > 3
     seL4_RISCV_Tera_Page,
+#endif
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    seL4_RISCV_64K_Page,
 #endif
     seL4_ModeObjectTypeCount
 } seL4_ModeObjectType;
@@ -20,3 +23,7 @@ typedef enum _mode_object {
 #if CONFIG_PT_LEVELS <= 3
 #define seL4_RISCV_Tera_Page 0xffffffff
 #endif
+
+#ifndef CONFIG_RISCV_EXT_SVNAPOT
+#define seL4_RISCV_64K_Page 0xffffffff
+#endif
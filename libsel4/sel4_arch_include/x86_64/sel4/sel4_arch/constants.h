@@ -31,9 +31,11 @@
 #define seL4_EndpointBits       4
 #ifdef CONFIG_KERNEL_MCS
 #define seL4_NotificationBits   6
+#define seL4_RingBits           7
 #define seL4_ReplyBits          5
 #else
 #define seL4_NotificationBits   5
+#define seL4_RingBits           6
 #endif
 
 #define seL4_PageTableBits      12
@@ -245,6 +245,8 @@ def init_data_types(wordsize):
 
         # seL4 Structures
         BitFieldType("seL4_CapRights_t", wordsize, wordsize),
+        # 5 counters, seL4_MDBStatsFanoutBuckets and seL4_MDBStatsTypeCount
+        StructType("seL4_MDBStats", wordsize * 33, wordsize),
 
         # Object types
         CapType("seL4_CPtr", wordsize),
@@ -256,6 +258,7 @@ def init_data_types(wordsize):
         CapType("seL4_DomainSet", wordsize),
         CapType("seL4_SchedContext", wordsize),
         CapType("seL4_SchedControl", wordsize),
+        CapType("seL4_Ring", wordsize),
     ]
 
     return types
@@ -597,7 +600,7 @@ def generate_result_struct(interface_name, method_name, output_params):
     return "\n".join(result)
 
 
-def generate_stub(arch, wordsize, interface_name, method_name, method_id, input_params, output_params, structs, use_only_ipc_buffer, comment, mcs):
+def generate_stub(arch, wordsize, interface_name, method_name, method_id, input_params, output_params, structs, use_only_ipc_buffer, comment, mcs, msg_length=""):
     result = []
 
     if use_only_ipc_buffer:
@@ -662,8 +665,10 @@ def generate_stub(arch, wordsize, interface_name, method_name, method_id, input_
     # Setup variables we will need.
     #
     result.append("\t%s result;" % return_type)
-    result.append("\tseL4_MessageInfo_t tag = seL4_MessageInfo_new(%s, 0, %d, %d);" %
-                  (method_id, len(cap_expressions), len(input_expressions)))
+    # A method can send more message registers than its parameters, which it
+    # then sets itself, by giving an expression for the length.
+    result.append("\tseL4_MessageInfo_t tag = seL4_MessageInfo_new(%s, 0, %d, %s);" %
+                  (method_id, len(cap_expressions), msg_length or len(input_expressions)))
     result.append("\tseL4_MessageInfo_t output_tag;")
     for i in range(num_mrs):
         result.append("\tseL4_Word mr%d;" % i)
@@ -865,6 +870,7 @@ def parse_xml_file(input_file, valid_types):
             method_condition = condition_to_cpp(method.getElementsByTagName("condition"))
             method_manual_name = method.getAttribute("manual_name") or method_name
             method_manual_label = method.getAttribute("manual_label")
+            method_msg_length = method.getAttribute("msg_length")
 
             if not method_manual_label:
                 # If no manual label is specified, infer one from the interface and method
@@ -963,7 +969,7 @@ def parse_xml_file(input_file, valid_types):
             comment = "\n".join(["/**"] + [" * %s" % l for l in comment_lines] + [" */"])
 
             methods.append((interface_name, method_name, method_id, input_params,
-                            output_params, method_condition, comment))
+                            output_params, method_condition, comment, method_msg_length))
 
     return (methods, structs, api)
 
@@ -1032,7 +1038,7 @@ def generate_stub_file(arch, input_files, output_file, use_only_ipc_buffer, mcs,
     result.append("/*")
     result.append(" * Return types for generated methods.")
     result.append(" */")
-    for (interface_name, method_name, _, _, output_params, _, _) in methods:
+    for (interface_name, method_name, _, _, output_params, _, _, _) in methods:
         results_structure = generate_result_struct(interface_name, method_name, output_params)
         if results_structure:
             result.append(results_structure)
@@ -1043,11 +1049,12 @@ def generate_stub_file(arch, input_files, output_file, use_only_ipc_buffer, mcs,
     result.append("/*")
     result.append(" * Generated stubs.")
     result.append(" */")
-    for (interface_name, method_name, method_id, inputs, outputs, condition, comment) in methods:
+    for (interface_name, method_name, method_id, inputs, outputs, condition, comment, msg_length) in methods:
         if condition != "":
             result.append("#if %s" % condition)
         result.append(generate_stub(arch, wordsize, interface_name, method_name,
-                                    method_id, inputs, outputs, structs, use_only_ipc_buffer, comment, mcs))
+                                    method_id, inputs, outputs, structs, use_only_ipc_buffer, comment, mcs,
+                                    msg_length))
         if condition != "":
             result.append("#endif")
 
@@ -472,7 +472,7 @@ def generate_stub_file(arch, input_files, output_file, use_only_ipc_buffer, mcs,
     result.append("/*")
     result.append(" * Return types for generated methods.")
     result.append(" */")
-    for (interface_name, method_name, _, _, output_params, _, _) in methods:
+    for (interface_name, method_name, _, _, output_params, _, _, _) in methods:
         results_structure = generate_result_struct(interface_name, method_name, output_params)
         if results_structure:
             result.append(results_structure)
@@ -483,7 +483,7 @@ def generate_stub_file(arch, input_files, output_file, use_only_ipc_buffer, mcs,
     result.append("/*")
     result.append(" * Generated stubs.")
     result.append(" */")
-    for (interface_name, method_name, method_id, inputs, outputs, condition, comment) in methods:
+    for (interface_name, method_name, method_id, inputs, outputs, condition, comment, _) in methods:
         if condition != "":
             if condition == "(!defined(CONFIG_KERNEL_MCS) && defined(CONFIG_ENABLE_SMP_SUPPORT))":
                 condition = 'all(not(feature = "CONFIG_KERNEL_MCS"), feature = "CONFIG_ENABLE_SMP_SUPPORT")'
@@ -209,7 +209,7 @@ def gen_invocations(input_files, output_dir, args):
                 groups[group_id_mcs] = group_name + " (MCS)"
 
             for (interface_name, method_name, method_id, inputs, outputs, condition,
-                 comment) in methods:
+                 comment, _) in methods:
                 g_id = group_id_mcs if is_mcs(condition) else group_id
                 prototype = "/**\n * @addtogroup %s\n * @{\n */\n\n" % g_id
                 prototype += generate_prototype(interface_name, method_name, method_id, inputs,
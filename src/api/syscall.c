@@ -20,6 +20,7 @@
 #include <machine/io.h>
 #include <plat/machine/hardware.h>
 #include <object/interrupt.h>
+#include <object/ring.h>
 #include <model/statedata.h>
 #include <string.h>
 #include <kernel/traps.h>
@@ -76,6 +77,46 @@ exception_t handleInterruptEntry(void)
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_KERNEL_SIGNAL_BATCH
+/* Signal each notification named in the first count message words of the
+ * caller's IPC buffer. Entries that do not name a notification cap with the
+ * Write right are skipped. Threads woken on other cores only mark them for
+ * rescheduling, so the reschedule IPIs are sent once by the caller's
+ * schedule(). */
+static void handleSignalBatch(word_t count)
+{
+    word_t *buffer;
+    word_t i;
+
+    if (unlikely(count > seL4_MsgMaxLength)) {
+        userError("SignalBatch: count %lu exceeds the message length.", count);
+        return;
+    }
+
+    buffer = lookupIPCBuffer(false, NODE_STATE(ksCurThread));
+    if (unlikely(buffer == NULL)) {
+        userError("SignalBatch: no IPC buffer.");
+        return;
+    }
+
+    for (i = 0; i < count; i++) {
+        /* Skip the message info word at the start of the IPC buffer */
+        cptr_t cptr = buffer[i + 1];
+        lookupCap_ret_t lu_ret = lookupCap(NODE_STATE(ksCurThread), cptr);
+
+        if (unlikely(lu_ret.status != EXCEPTION_NONE ||
+                     cap_get_capType(lu_ret.cap) != cap_notification_cap ||
+                     !cap_notification_cap_get_capNtfnCanSend(lu_ret.cap))) {
+            userError("SignalBatch: entry %lu (cptr %lu) is not a sendable notification.", i, cptr);
+            continue;
+        }
+
+        sendSignal(NTFN_PTR(cap_notification_cap_get_capNtfnPtr(lu_ret.cap)),
+                   cap_notification_cap_get_capNtfnBadge(lu_ret.cap));
+    }
+}
+#endif
+
 exception_t handleUnknownSyscall(word_t w)
 {
 #ifdef CONFIG_PRINTING
@@ -213,6 +254,18 @@ exception_t handleUnknownSyscall(word_t w)
     } /* end switch(w) */
 #endif /* CONFIG_ENABLE_BENCHMARKS */
 
+#ifdef CONFIG_KERNEL_SIGNAL_BATCH
+    if (w == SysSignalBatch) {
+        MCS_DO_IF_BUDGET({
+            handleSignalBatch(getRegister(NODE_STATE(ksCurThread), capRegister));
+        })
+        schedule();
+        activateThread();
+
+        return EXCEPTION_NONE;
+    }
+#endif
+
     MCS_DO_IF_BUDGET({
 #ifdef CONFIG_SET_TLS_BASE_SELF
         if (w == SysSetTLSBase)
@@ -471,6 +524,19 @@ static void handleRecv(bool_t isBlocking)
         receiveSignal(NODE_STATE(ksCurThread), lu_ret.cap, isBlocking);
         break;
     }
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap:
+        if (unlikely(!cap_ring_cap_get_capRingCanReceive(lu_ret.cap))) {
+            current_lookup_fault = lookup_fault_missing_capability_new(0);
+            current_fault = seL4_Fault_CapFault_new(epCPtr, true);
+            handleFault(NODE_STATE(ksCurThread));
+            break;
+        }
+
+        receiveRing(NODE_STATE(ksCurThread), RING_PTR(cap_ring_cap_get_capRingPtr(lu_ret.cap)),
+                    isBlocking);
+        break;
+#endif
     default:
         current_lookup_fault = lookup_fault_missing_capability_new(0);
         current_fault = seL4_Fault_CapFault_new(epCPtr, true);
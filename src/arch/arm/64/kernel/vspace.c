@@ -15,6 +15,7 @@
 #include <kernel/stack.h>
 #include <machine/io.h>
 #include <machine/debug.h>
+#include <model/preemption.h>
 #include <model/statedata.h>
 #include <object/cnode.h>
 #include <object/untyped.h>
@@ -225,7 +226,9 @@ BOOT_CODE void map_kernel_frame(paddr_t paddr, pptr_t vaddr, vm_rights_t vm_righ
         attr_index = DEVICE_nGnRnE;
         shareable = 0;
     }
-    armKSGlobalKernelPT[GET_KPT_INDEX(vaddr, KLVL_FRM_ARM_PT_LVL(3))] = pte_pte_4k_page_new(uxn, paddr,
+    armKSGlobalKernelPT[GET_KPT_INDEX(vaddr, KLVL_FRM_ARM_PT_LVL(3))] = pte_pte_4k_page_new(uxn,
+                                                                                            0, /* contiguous */
+                                                                                            paddr,
                                                                                             0, /* global */
                                                                                             1, /* access flag */
                                                                                             shareable,
@@ -254,12 +257,20 @@ BOOT_CODE void map_kernel_window(void)
 
     /* place the PUD into the PGD */
     armKSGlobalKernelPGD[GET_KPT_INDEX(PPTR_BASE, KLVL_FRM_ARM_PT_LVL(0))] = pte_pte_table_new(
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+                                                                                 0, /* no_write */
+                                                                                 0, /* shared */
+#endif
                                                                                  addrFromKPPtr(armKSGlobalKernelPUD));
 
     /* place all PDs except the last one in PUD */
     for (idx = GET_KPT_INDEX(PPTR_BASE, KLVL_FRM_ARM_PT_LVL(1)); idx < GET_KPT_INDEX(PPTR_TOP, KLVL_FRM_ARM_PT_LVL(1));
          idx++) {
         armKSGlobalKernelPUD[idx] = pte_pte_table_new(
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+                                        0, /* no_write */
+                                        0, /* shared */
+#endif
                                         addrFromKPPtr(&armKSGlobalKernelPDs[idx][0])
                                     );
     }
@@ -274,6 +285,7 @@ BOOT_CODE void map_kernel_window(void)
 #else
                                                                                                                         1, // UXN
 #endif
+                                                                                                                        0,                        /* contiguous */
                                                                                                                         paddr,
                                                                                                                         0,                        /* global */
                                                                                                                         1,                        /* access flag */
@@ -286,11 +298,19 @@ BOOT_CODE void map_kernel_window(void)
 
     /* put the PD into the PUD for device window */
     armKSGlobalKernelPUD[GET_KPT_INDEX(PPTR_TOP, KLVL_FRM_ARM_PT_LVL(1))] = pte_pte_table_new(
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+                                                                                0, /* no_write */
+                                                                                0, /* shared */
+#endif
                                                                                 addrFromKPPtr(&armKSGlobalKernelPDs[BIT(PT_INDEX_BITS) - 1][0])
                                                                             );
 
     /* put the PT into the PD for device window */
     armKSGlobalKernelPDs[BIT(PT_INDEX_BITS) - 1][BIT(PT_INDEX_BITS) - 1] = pte_pte_table_new(
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+                                                                               0, /* no_write */
+                                                                               0, /* shared */
+#endif
                                                                                addrFromKPPtr(armKSGlobalKernelPT)
                                                                            );
 
@@ -325,10 +345,35 @@ static BOOT_CODE void map_it_frame_cap(cap_t vspace_cap, cap_t frame_cap, bool_t
     assert(pte_pte_table_ptr_get_present(pud));
     pd = paddr_to_pptr(pte_pte_table_ptr_get_pt_base_address(pud));
     pd += GET_UPT_INDEX(vptr, ULVL_FRM_ARM_PT_LVL(2));
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+    if (cap_frame_cap_get_capFSize(frame_cap) == ARMLargePage) {
+        assert(!pte_ptr_get_valid(pd));
+        *pd = pte_pte_page_new(
+                  !executable,                    /* unprivileged execute never */
+                  0,                              /* contiguous           */
+                  pptr_to_paddr(pptr),            /* page_base_address    */
+#ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
+                  0,
+#else
+                  1,                              /* not global */
+#endif
+                  1,                              /* access flag */
+                  SMP_TERNARY(SMP_SHARE, 0),      /* Inner-shareable if SMP enabled, otherwise unshared */
+                  APFromVMRights(VMReadWrite),
+#ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
+                  S2_NORMAL
+#else
+                  NORMAL
+#endif
+              );
+        return;
+    }
+#endif
     assert(pte_pte_table_ptr_get_present(pd));
     pt = paddr_to_pptr(pte_pte_table_ptr_get_pt_base_address(pd));
     *(pt + GET_UPT_INDEX(vptr, ULVL_FRM_ARM_PT_LVL(3))) = pte_pte_4k_page_new(
                                                               !executable,                    /* unprivileged execute never */
+                                                              0,                              /* contiguous           */
                                                               pptr_to_paddr(pptr),            /* page_base_address    */
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
                                                               0,
@@ -386,6 +431,10 @@ static BOOT_CODE void map_it_pt_cap(cap_t vspace_cap, cap_t pt_cap)
     assert(pte_pte_table_ptr_get_present(pud));
     pd = paddr_to_pptr(pte_pte_table_ptr_get_pt_base_address(pud));
     *(pd + GET_UPT_INDEX(vptr, ULVL_FRM_ARM_PT_LVL(2))) = pte_pte_table_new(
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+                                                              0, /* no_write */
+                                                              0, /* shared */
+#endif
                                                               pptr_to_paddr(pt)
                                                           );
 }
@@ -396,6 +445,9 @@ static BOOT_CODE cap_t create_it_pt_cap(cap_t vspace_cap, pptr_t pptr, vptr_t vp
     cap = cap_page_table_cap_new(
               asid,                   /* capPTMappedASID */
               pptr,                   /* capPTBasePtr */
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+              0,                      /* capPTIsShared */
+#endif
               1,                      /* capPTIsMapped */
               vptr                    /* capPTMappedAddress */
           );
@@ -420,6 +472,10 @@ static BOOT_CODE void map_it_pd_cap(cap_t vspace_cap, cap_t pd_cap)
     pud = paddr_to_pptr(pte_pte_table_ptr_get_pt_base_address(vspaceRoot));
 #endif
     *(pud + GET_UPT_INDEX(vptr, ULVL_FRM_ARM_PT_LVL(1))) = pte_pte_table_new(
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+                                                               0, /* no_write */
+                                                               0, /* shared */
+#endif
                                                                pptr_to_paddr(pd)
                                                            );
 }
@@ -430,6 +486,9 @@ static BOOT_CODE cap_t create_it_pd_cap(cap_t vspace_cap, pptr_t pptr, vptr_t vp
     cap = cap_page_table_cap_new(
               asid,                   /* capPTMappedASID */
               pptr,                   /* capPTBasePtr */
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+              0,                      /* capPTIsShared */
+#endif
               1,                      /* capPTIsMapped */
               vptr                    /* capPTMappedAddress */
           );
@@ -447,6 +506,10 @@ static BOOT_CODE void map_it_pud_cap(cap_t vspace_cap, cap_t pud_cap)
     assert(cap_page_table_cap_get_capPTIsMapped(pud_cap));
 
     *(pgd + GET_UPT_INDEX(vptr, ULVL_FRM_ARM_PT_LVL(0))) = pte_pte_table_new(
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+                                                               0, /* no_write */
+                                                               0, /* shared */
+#endif
                                                                pptr_to_paddr(pud));
 }
 
@@ -456,6 +519,9 @@ static BOOT_CODE cap_t create_it_pud_cap(cap_t vspace_cap, pptr_t pptr, vptr_t v
     cap = cap_page_table_cap_new(
               asid,               /* capPTMappedASID */
               pptr,               /* capPTBasePtr */
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+              0,                  /* capPTIsShared */
+#endif
               1,                  /* capPTIsMapped */
               vptr                /* capPTMappedAddress */
           );
@@ -465,12 +531,17 @@ static BOOT_CODE cap_t create_it_pud_cap(cap_t vspace_cap, pptr_t pptr, vptr_t v
 #endif /* AARCH64_VSPACE_S2_START_L1 */
 BOOT_CODE word_t arch_get_n_paging(v_region_t it_v_reg)
 {
-    return
+    word_t n =
 #ifndef AARCH64_VSPACE_S2_START_L1
         get_n_paging(it_v_reg, GET_ULVL_PGSIZE_BITS(ULVL_FRM_ARM_PT_LVL(0))) +
 #endif
         get_n_paging(it_v_reg, GET_ULVL_PGSIZE_BITS(ULVL_FRM_ARM_PT_LVL(1))) +
         get_n_paging(it_v_reg, GET_ULVL_PGSIZE_BITS(ULVL_FRM_ARM_PT_LVL(2)));
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+    /* no PT is needed where a large frame is mapped directly into a PD */
+    n -= get_n_it_large_frames();
+#endif
+    return n;
 }
 
 BOOT_CODE cap_t create_it_address_space(cap_t root_cnode_cap, v_region_t it_v_reg)
@@ -515,6 +586,11 @@ BOOT_CODE cap_t create_it_address_space(cap_t root_cnode_cap, v_region_t it_v_re
     for (vptr = ROUND_DOWN(it_v_reg.start, GET_ULVL_PGSIZE_BITS(ULVL_FRM_ARM_PT_LVL(2)));
          vptr < it_v_reg.end;
          vptr += GET_ULVL_PGSIZE(ULVL_FRM_ARM_PT_LVL(2))) {
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+        if (is_it_large_frame(vptr)) {
+            continue;
+        }
+#endif
         if (!provide_cap(root_cnode_cap, create_it_pt_cap(vspace_cap, it_alloc_paging(), vptr, IT_ASID))) {
             return cap_null_cap_new();
         }
@@ -550,6 +626,10 @@ BOOT_CODE void activate_kernel_vspace(void)
 
     invalidateLocalTLB();
     lockTLBEntry(KERNEL_ELF_BASE);
+
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+    armKSVMIDBits = has16BitVMIDs() ? VMID_MAX_BITS : hwASIDBits;
+#endif
 }
 
 BOOT_CODE void write_it_asid_pool(cap_t it_ap_cap, cap_t it_vspace_cap)
@@ -559,10 +639,17 @@ BOOT_CODE void write_it_asid_pool(cap_t it_ap_cap, cap_t it_vspace_cap)
 #ifdef CONFIG_ARM_SMMU
                               /* bind_cb: Number of bound context banks */
                               0,
+#endif
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+                              /* stored_hw_vmid: Assigned hardware VMID for TLB. */
+                              0,
 #endif
                               /* vspace_root: reference to vspace root page table object */
                               (word_t)cap_vspace_cap_get_capVSBasePtr(it_vspace_cap)
-#ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
+#if defined(CONFIG_ARM_VMID_GENERATIONS)
+                              /* vmid_generation, stored_vmid_valid: Allocator generation of the stored VMID. */
+                              , 0, false
+#elif defined(CONFIG_ARM_HYPERVISOR_SUPPORT)
                               /* stored_hw_vmid, stored_vmid_valid: Assigned hardware VMID for TLB. */
                               , 0, false
 #endif
@@ -657,6 +744,85 @@ exception_t checkValidIPCBuffer(vptr_t vptr, cap_t cap)
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+/* The table descriptor that links a shared page table into a sharer's VSpace
+ * has the shared and no_write fields set, see structures.bf. */
+static inline bool_t isSharedPTLink(pte_t *ptSlot)
+{
+    return pte_pte_table_ptr_get_present(ptSlot) && pte_pte_table_ptr_get_shared(ptSlot);
+}
+
+static shared_pt_t *findSharedPT(pte_t *pt)
+{
+    for (word_t i = 0; i < CONFIG_ARM_MAX_SHARED_PAGE_TABLES; i++) {
+        if (armKSSharedPTs[i].pt == pt) {
+            return &armKSSharedPTs[i];
+        }
+    }
+    return NULL;
+}
+
+/* Changes to the page tables of an owner are seen by every sharer, whose TLB
+ * entries are tagged with their own ASIDs. */
+static bool_t isSharedPTOwner(asid_t asid)
+{
+    if (likely(armKSNumSharedPTs == 0)) {
+        return false;
+    }
+    for (word_t i = 0; i < CONFIG_ARM_MAX_SHARED_PAGE_TABLES; i++) {
+        if (armKSSharedPTs[i].pt != NULL && armKSSharedPTs[i].owner == asid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Whether the owner of a shared page table reaches it through the table pt. */
+static bool_t isSharedPTBelow(vspace_root_t *vspace, shared_pt_t *spt, pte_t *pt)
+{
+    pte_t *next = vspace;
+
+    for (word_t i = 0; i < UPT_LEVELS - 1 && next != spt->pt; i++) {
+        pte_t *ptSlot = next + GET_UPT_INDEX(spt->vaddr, i);
+        if (!pte_pte_table_ptr_get_present(ptSlot)) {
+            return false;
+        }
+        next = paddr_to_pptr(pte_pte_table_ptr_get_pt_base_address(ptSlot));
+        if (next == pt) {
+            return next != spt->pt;
+        }
+    }
+    return false;
+}
+
+/* The mappings made through a shared page table can no longer be found from
+ * their caps once the owner's VSpace is deleted or a table above the shared
+ * table is unmapped from it, so the frames and tables they refer to may be
+ * deleted while the sharers still use them. The tables are emptied instead,
+ * leaving the sharers linked to empty tables. A NULL pt releases every shared
+ * table owned by the ASID. */
+static void releaseSharedPTs(asid_t asid, vspace_root_t *vspace, pte_t *pt)
+{
+    bool_t released = false;
+
+    if (likely(armKSNumSharedPTs == 0)) {
+        return;
+    }
+    for (word_t i = 0; i < CONFIG_ARM_MAX_SHARED_PAGE_TABLES; i++) {
+        shared_pt_t *spt = &armKSSharedPTs[i];
+        if (spt->pt != NULL && spt->owner == asid &&
+            (pt == NULL || isSharedPTBelow(vspace, spt, pt))) {
+            clearMemory_PT((word_t *)spt->pt, seL4_PageTableBits);
+            spt->owner = asidInvalid;
+            released = true;
+        }
+    }
+    if (released) {
+        invalidateTranslationAll();
+    }
+}
+#endif
+
 static lookupPTSlot_ret_t lookupPTSlot(vspace_root_t *vspace, vptr_t vptr)
 {
     lookupPTSlot_ret_t ret;
@@ -672,7 +838,14 @@ static lookupPTSlot_ret_t lookupPTSlot(vspace_root_t *vspace, vptr_t vptr)
     ret.ptBitsLeft = PT_INDEX_BITS * level + seL4_PageBits;
     ret.ptSlot = pt + ((vptr >> ret.ptBitsLeft) & MASK(seL4_VSpaceIndexBits));
 
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+    /* A sharer cannot reach into a shared page table, so the walk stops at
+     * the link to it as if it was a mapping. */
+    while (pte_pte_table_ptr_get_present(ret.ptSlot) && !pte_pte_table_ptr_get_shared(ret.ptSlot) &&
+           likely(level > 0)) {
+#else
     while (pte_pte_table_ptr_get_present(ret.ptSlot) && likely(level > 0)) {
+#endif
         level--;
         ret.ptBitsLeft -= PT_INDEX_BITS;
         pt = paddr_to_pptr(pte_pte_table_ptr_get_pt_base_address(ret.ptSlot));
@@ -702,10 +875,10 @@ static pte_t makeUserPagePTE(paddr_t paddr, vm_rights_t vm_rights, vm_attributes
     word_t shareable = cacheable ? SMP_TERNARY(SMP_SHARE, 0) : 0;
 
     if (page_size == ARMSmallPage) {
-        return pte_pte_4k_page_new(nonexecutable, paddr, nG, 1 /* access flag */,
+        return pte_pte_4k_page_new(nonexecutable, 0 /* contiguous */, paddr, nG, 1 /* access flag */,
                                    shareable, APFromVMRights(vm_rights), attridx);
     } else {
-        return pte_pte_page_new(nonexecutable, paddr, nG, 1 /* access flag */,
+        return pte_pte_page_new(nonexecutable, 0 /* contiguous */, paddr, nG, 1 /* access flag */,
                                 shareable, APFromVMRights(vm_rights), attridx);
     }
 }
@@ -841,6 +1014,185 @@ static void invalidateASID(asid_t asid)
     setASIDMap(poolPtr, asid, asid_map);
 }
 
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+
+static void storeHWASID(asid_t asid, hw_asid_t hw_asid)
+{
+    asid_pool_t *poolPtr;
+    asid_map_t asid_map;
+
+    poolPtr = getPoolPtr(asid);
+    asid_map = getASIDMap(poolPtr, asid);
+    assert(asid_map_get_type(asid_map) == asid_map_asid_map_vspace);
+
+    asid_map = asid_map_asid_map_vspace_set_stored_hw_vmid(asid_map, hw_asid);
+    asid_map = asid_map_asid_map_vspace_set_vmid_generation(asid_map, armKSVMIDGeneration);
+    asid_map = asid_map_asid_map_vspace_set_stored_vmid_valid(asid_map, true);
+
+    setASIDMap(poolPtr, asid, asid_map);
+}
+
+static inline void setVMIDAllocated(word_t vmid)
+{
+    armKSVMIDBitmap[vmid >> wordRadix] |= BIT(vmid & MASK(wordRadix));
+}
+
+static inline void clearVMIDAllocated(word_t vmid)
+{
+    armKSVMIDBitmap[vmid >> wordRadix] &= ~BIT(vmid & MASK(wordRadix));
+}
+
+/* Whether the ASID last loaded on a core still owns the VMID that core
+ * is running with, so that it can carry that VMID into the next generation. */
+static bool_t isActiveVMIDOwner(asid_t asid, hw_asid_t vmid)
+{
+    asid_pool_t *poolPtr;
+    asid_map_t asid_map;
+
+    poolPtr = getPoolPtr(asid);
+    if (poolPtr == NULL) {
+        return false;
+    }
+    asid_map = getASIDMap(poolPtr, asid);
+    return asid_map_get_type(asid_map) == asid_map_asid_map_vspace &&
+           asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map) &&
+           asid_map_asid_map_vspace_get_stored_hw_vmid(asid_map) == vmid;
+}
+
+/* The generation number wrapped, so a stored VMID from an old generation
+ * could compare equal to the new one. Forget every stored VMID; this
+ * happens once every BIT(VMID_GENERATION_BITS) rollovers. */
+static void invalidateAllStoredVMIDs(void)
+{
+    for (word_t high = 0; high < nASIDPools; high++) {
+        asid_pool_t *poolPtr = armKSASIDTable[high];
+        if (poolPtr == NULL) {
+            continue;
+        }
+        for (word_t low = 0; low < BIT(asidLowBits); low++) {
+            asid_map_t asid_map = poolPtr->array[low];
+            if (asid_map_get_type(asid_map) == asid_map_asid_map_vspace) {
+                asid_map = asid_map_asid_map_vspace_set_stored_hw_vmid(asid_map, 0);
+                asid_map = asid_map_asid_map_vspace_set_stored_vmid_valid(asid_map, false);
+                poolPtr->array[low] = asid_map;
+            }
+        }
+    }
+}
+
+/* All VMIDs of the current generation are in use. Start a new generation
+ * in which only the VMIDs currently loaded on some core stay allocated.
+ * Instead of flushing the TLB for every VMID that gets reused, each core
+ * flushes its local TLB once before it next loads a VMID. */
+static void newVMIDGeneration(void)
+{
+    bool_t keep[CONFIG_MAX_NUM_NODES];
+
+    for (word_t cpu = 0; cpu < CONFIG_MAX_NUM_NODES; cpu++) {
+        keep[cpu] = isActiveVMIDOwner(ARCH_NODE_STATE_ON_CORE(armKSActiveASID, cpu),
+                                      ARCH_NODE_STATE_ON_CORE(armKSActiveVMID, cpu));
+    }
+
+    armKSVMIDGeneration = (armKSVMIDGeneration + 1) & MASK(VMID_GENERATION_BITS);
+    if (armKSVMIDGeneration == 0) {
+        invalidateAllStoredVMIDs();
+    }
+
+    memzero(armKSVMIDBitmap, sizeof(armKSVMIDBitmap));
+    armKSNextVMID = 0;
+
+    for (word_t cpu = 0; cpu < CONFIG_MAX_NUM_NODES; cpu++) {
+        hw_asid_t vmid = ARCH_NODE_STATE_ON_CORE(armKSActiveVMID, cpu);
+        setVMIDAllocated(vmid);
+        if (keep[cpu]) {
+            storeHWASID(ARCH_NODE_STATE_ON_CORE(armKSActiveASID, cpu), vmid);
+        }
+        ARCH_NODE_STATE_ON_CORE(armKSVMIDCoreGeneration, cpu) = VMID_GENERATION_INVALID;
+    }
+}
+
+/* Scan forward from armKSNextVMID, so that handing out every VMID of a
+ * generation costs one pass over the bitmap. Returns 0 when none is left. */
+static word_t findNextFreeVMID(void)
+{
+    word_t nVMIDs = BIT(armKSVMIDBits);
+
+    /* VMID 0 tags the global user vspace */
+    if (armKSNextVMID == 0) {
+        armKSNextVMID = 1;
+    }
+    while (armKSNextVMID < nVMIDs) {
+        word_t avail = ~armKSVMIDBitmap[armKSNextVMID >> wordRadix] &
+                       ~MASK(armKSNextVMID & MASK(wordRadix));
+        if (avail) {
+            word_t vmid = (armKSNextVMID & ~MASK(wordRadix)) + ctzl(avail);
+            if (vmid >= nVMIDs) {
+                break;
+            }
+            armKSNextVMID = vmid + 1;
+            return vmid;
+        }
+        armKSNextVMID = (armKSNextVMID & ~MASK(wordRadix)) + wordBits;
+    }
+    armKSNextVMID = nVMIDs;
+    return 0;
+}
+
+static hw_asid_t findFreeHWASID(void)
+{
+    word_t vmid;
+
+    vmid = findNextFreeVMID();
+    if (vmid == 0) {
+        newVMIDGeneration();
+        vmid = findNextFreeVMID();
+        /* At most one VMID per core survives a rollover */
+        assert(vmid != 0);
+    }
+    setVMIDAllocated(vmid);
+
+    return vmid;
+}
+
+hw_asid_t getHWASID(asid_t asid)
+{
+    asid_map_t asid_map;
+    hw_asid_t hw_asid;
+
+    asid_map = findMapForASID(asid);
+    if (asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map) &&
+        asid_map_asid_map_vspace_get_vmid_generation(asid_map) == armKSVMIDGeneration) {
+        hw_asid = asid_map_asid_map_vspace_get_stored_hw_vmid(asid_map);
+    } else {
+        hw_asid = findFreeHWASID();
+        storeHWASID(asid, hw_asid);
+    }
+
+    /* A VMID may have been reused since this core last flushed its TLB */
+    if (unlikely(ARCH_NODE_STATE(armKSVMIDCoreGeneration) != armKSVMIDGeneration)) {
+        invalidateTranslationAllLocal();
+        ARCH_NODE_STATE(armKSVMIDCoreGeneration) = armKSVMIDGeneration;
+    }
+    ARCH_NODE_STATE(armKSActiveASID) = asid;
+    ARCH_NODE_STATE(armKSActiveVMID) = hw_asid;
+
+    return hw_asid;
+}
+
+static void invalidateASIDEntry(asid_t asid)
+{
+    asid_map_t asid_map;
+
+    asid_map = findMapForASID(asid);
+    if (asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map) &&
+        asid_map_asid_map_vspace_get_vmid_generation(asid_map) == armKSVMIDGeneration) {
+        clearVMIDAllocated(asid_map_asid_map_vspace_get_stored_hw_vmid(asid_map));
+    }
+    invalidateASID(asid);
+}
+
+#else
+
 static void storeHWASID(asid_t asid, hw_asid_t hw_asid)
 {
     asid_pool_t *poolPtr;
@@ -915,6 +1267,8 @@ static void invalidateASIDEntry(asid_t asid)
     invalidateASID(asid);
 }
 
+#endif /* CONFIG_ARM_VMID_GENERATIONS */
+
 #endif
 
 #ifdef CONFIG_ARM_SMMU
@@ -975,6 +1329,12 @@ static inline void invalidateTLBByASID(asid_t asid)
     }
     invalidateTranslationASID(asid_map_asid_map_vspace_get_stored_hw_vmid(asid_map));
 #else
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+    if (unlikely(isSharedPTOwner(asid))) {
+        invalidateTranslationAll();
+        return;
+    }
+#endif
     invalidateTranslationASID(asid);
 #endif
 }
@@ -997,10 +1357,86 @@ static inline void invalidateTLBByASIDVA(asid_t asid, vptr_t vaddr)
     uint64_t hw_asid = asid_map_asid_map_vspace_get_stored_hw_vmid(asid_map);
     invalidateTranslationSingle((hw_asid << 48) | vaddr >> seL4_PageBits);
 #else
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+    if (unlikely(isSharedPTOwner(asid))) {
+        invalidateTranslationAll();
+        return;
+    }
+#endif
     invalidateTranslationSingle((asid << 48) | vaddr >> seL4_PageBits);
 #endif
 }
 
+#ifdef CONFIG_ARM_CONTIGUOUS_HINT
+/* With the 4K granule, a contiguous group is 16 entries at levels 2 and 3. */
+#define PTE_CONT_BITS 4
+
+static inline pte_t *contiguousGroup(pte_t *ptSlot)
+{
+    return (pte_t *)ROUND_DOWN((word_t)ptSlot, PTE_CONT_BITS + seL4_PageTableEntryBits);
+}
+
+/* Changing the contiguous bit of valid entries needs break-before-make: the
+ * group is invalidated and cleaned, the TLB flushed, and only then are the
+ * entries written back with the new bit. The option is limited to builds in
+ * which no other core or SMMU can walk the group while it is invalid, as that
+ * would raise a fault for the user to handle. */
+static void rewriteContiguousGroup(asid_t asid, pte_t *group, bool_t contiguous)
+{
+    pte_t entries[BIT(PTE_CONT_BITS)];
+    vptr_t last = (vptr_t)(group + BIT(PTE_CONT_BITS)) - 1;
+    word_t i;
+
+    for (i = 0; i < BIT(PTE_CONT_BITS); i++) {
+        entries[i] = group[i];
+        group[i] = pte_pte_invalid_new();
+    }
+    cleanCacheRange_PoU((vptr_t)group, last, pptr_to_paddr(group));
+    assert(asid < BIT(16));
+    invalidateTLBByASID(asid);
+
+    for (i = 0; i < BIT(PTE_CONT_BITS); i++) {
+        group[i] = pte_set_contiguous(entries[i], contiguous);
+    }
+    cleanCacheRange_PoU((vptr_t)group, last, pptr_to_paddr(group));
+}
+
+/* Clear the contiguous bit of the group ptSlot belongs to, which must be done
+ * before any entry of the group is changed. */
+static void breakContiguousGroup(asid_t asid, pte_t *ptSlot)
+{
+    if (pte_is_page_type(*ptSlot) && pte_get_contiguous(*ptSlot)) {
+        rewriteContiguousGroup(asid, contiguousGroup(ptSlot), false);
+    }
+}
+
+/* Set the contiguous bit on the group ptSlot belongs to if its entries map a
+ * naturally aligned, physically contiguous region with identical attributes. */
+static void makeContiguousGroup(asid_t asid, pte_t *ptSlot, word_t pageBits)
+{
+    if (pageBits != seL4_PageBits && pageBits != seL4_LargePageBits) {
+        return;
+    }
+
+    pte_t *group = contiguousGroup(ptSlot);
+    pte_t first = group[0];
+    if (!pte_is_page_type(first) || pte_get_contiguous(first) ||
+        !IS_ALIGNED(pte_get_page_base_address(first), pageBits + PTE_CONT_BITS)) {
+        return;
+    }
+    /* As the base address is aligned to the size of the group, adding the
+     * offset of an entry only changes address bits, so comparing whole words
+     * also compares the type and every attribute. */
+    for (word_t i = 1; i < BIT(PTE_CONT_BITS); i++) {
+        if (group[i].words[0] != first.words[0] + (i << pageBits)) {
+            return;
+        }
+    }
+
+    rewriteContiguousGroup(asid, group, true);
+}
+#endif /* CONFIG_ARM_CONTIGUOUS_HINT */
+
 
 void unmapPageTable(asid_t asid, vptr_t vptr, pte_t *target_pt)
 {
@@ -1027,6 +1463,9 @@ void unmapPageTable(asid_t asid, vptr_t vptr, pte_t *target_pt)
     }
     /* If we found a pt then ptSlot won't be null */
     assert(ptSlot != NULL);
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+    releaseSharedPTs(asid, find_ret.vspace_root, target_pt);
+#endif
     *ptSlot = pte_pte_invalid_new();
     cleanByVA_PoU((vptr_t)ptSlot, pptr_to_paddr(ptSlot));
     invalidateTLBByASID(asid);
@@ -1060,12 +1499,39 @@ void unmapPage(vm_page_size_t page_size, asid_t asid, vptr_t vptr, pptr_t pptr)
         return;
     }
 
+#ifdef CONFIG_ARM_CONTIGUOUS_HINT
+    breakContiguousGroup(asid, lu_ret.ptSlot);
+#endif
     *(lu_ret.ptSlot) = pte_pte_invalid_new();
     cleanByVA_PoU((vptr_t)lu_ret.ptSlot, pptr_to_paddr(lu_ret.ptSlot));
     assert(asid < BIT(16));
     invalidateTLBByASIDVA(asid, vptr);
 }
 
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+/* Remove the link to a shared page table from the sharer's VSpace. Once the
+ * last cap to the table is gone, the owner's mapping is removed as well, as
+ * no cap is left to do it. */
+void unmapSharedPageTable(cap_t cap, bool_t final)
+{
+    pte_t *pt = PTE_PTR(cap_page_table_cap_get_capPTBasePtr(cap));
+    shared_pt_t *spt = findSharedPT(pt);
+
+    assert(spt != NULL && spt->sharers > 0);
+    unmapPageTable(cap_page_table_cap_get_capPTMappedASID(cap),
+                   cap_page_table_cap_get_capPTMappedAddress(cap), pt);
+    if (final && spt->owner != asidInvalid) {
+        unmapPageTable(spt->owner, spt->vaddr, pt);
+    }
+
+    spt->sharers--;
+    if (spt->sharers == 0) {
+        spt->pt = NULL;
+        armKSNumSharedPTs--;
+    }
+}
+#endif
+
 void deleteASID(asid_t asid, vspace_root_t *vspace)
 {
     asid_pool_t *poolPtr;
@@ -1076,6 +1542,9 @@ void deleteASID(asid_t asid, vspace_root_t *vspace)
         asid_map_t asid_map = poolPtr->array[ASID_LOW(asid)];
         if (asid_map_get_type(asid_map) == asid_map_asid_map_vspace &&
             (vspace_root_t *)asid_map_asid_map_vspace_get_vspace_root(asid_map) == vspace) {
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+            releaseSharedPTs(asid, vspace, NULL);
+#endif
             invalidateTLBByASID(asid);
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
             invalidateASIDEntry(asid);
@@ -1096,6 +1565,9 @@ void deleteASIDPool(asid_t asid_base, asid_pool_t *pool)
         for (offset = 0; offset < BIT(asidLowBits); offset++) {
             asid_map_t asid_map = pool->array[offset];
             if (asid_map_get_type(asid_map) == asid_map_asid_map_vspace) {
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+                releaseSharedPTs(asid_base + offset, NULL, NULL);
+#endif
                 invalidateTLBByASID(asid_base + offset);
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
                 invalidateASIDEntry(asid_base + offset);
@@ -1170,52 +1642,266 @@ static exception_t performVSpaceFlush(word_t invLabel, vspace_root_t *vspaceRoot
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_ARM_CACHE_FLUSH_BATCH
+#define FLUSH_BATCH_LINE(a) ROUND_DOWN(a, L1_CACHE_LINE_SIZE_BITS)
 
-static exception_t performPageTableInvocationMap(cap_t cap, cte_t *ctSlot, pte_t pte, pte_t *ptSlot)
+typedef struct lookupFlushBatchEntry_ret {
+    exception_t status;
+    word_t op;
+    /* The range to operate on by address, which is the kernel alias of the
+     * frame in hypervisor mode, with an inclusive end, and its physical
+     * address. There is nothing to do if the page is not mapped. */
+    bool_t empty;
+    vptr_t start;
+    vptr_t end;
+    paddr_t pstart;
+} lookupFlushBatchEntry_ret_t;
+
+/* Resolve entry i of a FlushBatch invocation, applying the same checks as the
+ * single range flush invocations. */
+static lookupFlushBatchEntry_ret_t lookupFlushBatchEntry(vspace_root_t *vspaceRoot, word_t *buffer,
+                                                         word_t i)
 {
-    ctSlot->cap = cap;
-    *ptSlot = pte;
-    cleanByVA_PoU((vptr_t)ptSlot, pptr_to_paddr(ptSlot));
+    lookupFlushBatchEntry_ret_t ret;
+    word_t mr = seL4_ARM_FlushBatchFirstMR + i * seL4_ARM_FlushBatchEntryWords;
+    vptr_t start = buffer[mr + 1];
+    word_t size = buffer[mr + 2] >> seL4_ARM_FlushBatchOpBits;
+    lookupPTSlot_ret_t resolve_ret;
+    pte_t pte;
 
-    return EXCEPTION_NONE;
-}
+    ret.status = EXCEPTION_NONE;
+    ret.op = buffer[mr + 2] & MASK(seL4_ARM_FlushBatchOpBits);
+    ret.empty = true;
 
-static exception_t performPageTableInvocationUnmap(cap_t cap, cte_t *ctSlot)
-{
-    if (cap_page_table_cap_get_capPTIsMapped(cap)) {
-        pte_t *pt = PT_PTR(cap_page_table_cap_get_capPTBasePtr(cap));
-        unmapPageTable(cap_page_table_cap_get_capPTMappedASID(cap),
-                       cap_page_table_cap_get_capPTMappedAddress(cap), pt);
-        clearMemory_PT((void *)pt, cap_get_capSizeBits(cap));
+    if (unlikely(size == 0 || start + size < start)) {
+        userError("VSpaceRoot FlushBatch: Invalid range in entry %lu.", i);
+        current_syscall_error.type = seL4_InvalidArgument;
+        current_syscall_error.invalidArgumentNumber = mr + 1;
+        ret.status = EXCEPTION_SYSCALL_ERROR;
+        return ret;
     }
+    ret.start = start;
+    ret.end = start + size - 1;
 
-    cap_page_table_cap_ptr_set_capPTIsMapped(&(ctSlot->cap), 0);
-    return EXCEPTION_NONE;
-}
+    /* Don't let applications flush kernel regions. */
+    if (unlikely(ret.end >= USER_TOP)) {
+        userError("VSpaceRoot FlushBatch: Entry %lu exceeds the user addressable region.", i);
+        current_syscall_error.type = seL4_IllegalOperation;
+        ret.status = EXCEPTION_SYSCALL_ERROR;
+        return ret;
+    }
 
-static exception_t performPageInvocationMap(asid_t asid, cap_t cap, cte_t *ctSlot,
-                                            pte_t pte, pte_t *ptSlot)
-{
-    bool_t tlbflush_required = pte_ptr_get_valid(ptSlot);
+    resolve_ret = lookupPTSlot(vspaceRoot, start);
+    pte = *resolve_ret.ptSlot;
+    if (!pte_is_page_type(pte)) {
+        /* As for a single range, there is no stale cached data to flush. */
+        return ret;
+    }
 
-    ctSlot->cap = cap;
-    *ptSlot = pte;
+    if (unlikely(ROUND_DOWN(start, resolve_ret.ptBitsLeft) != ROUND_DOWN(ret.end, resolve_ret.ptBitsLeft))) {
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = start;
+        current_syscall_error.rangeErrorMax = ROUND_DOWN(start, resolve_ret.ptBitsLeft) +
+                                              MASK(resolve_ret.ptBitsLeft);
+        userError("VSpaceRoot FlushBatch: entry %lu crosses a page boundary, valid range is [0x%lx..0x%lx)",
+                  i, current_syscall_error.rangeErrorMin, current_syscall_error.rangeErrorMax);
+        ret.status = EXCEPTION_SYSCALL_ERROR;
+        return ret;
+    }
 
-    cleanByVA_PoU((vptr_t)ptSlot, pptr_to_paddr(ptSlot));
-    if (unlikely(tlbflush_required)) {
-        assert(asid < BIT(16));
-        invalidateTLBByASIDVA(asid, cap_frame_cap_get_capFMappedAddress(cap));
+#ifndef CONFIG_ARM_HYPERVISOR_SUPPORT
+    if (unlikely(ret.op == seL4_ARM_FlushBatch_Invalidate && vmRightsFromPTE(pte) != VMReadWrite)) {
+        userError("VSpaceRoot FlushBatch: Cannot invalidate mapping without write rights.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        ret.status = EXCEPTION_SYSCALL_ERROR;
+        return ret;
     }
+#endif
 
-    return EXCEPTION_NONE;
+    ret.pstart = pte_get_page_base_address(pte) + (start & MASK(resolve_ret.ptBitsLeft));
+    if (config_set(CONFIG_ARM_HYPERVISOR_SUPPORT)) {
+        ret.start = (vptr_t)paddr_to_pptr(ret.pstart);
+        ret.end = ret.start + size - 1;
+    }
+    ret.empty = false;
+    return ret;
 }
 
-static exception_t performPageInvocationUnmap(cap_t cap, cte_t *ctSlot)
+/* The entries are applied a cache level at a time, in the order used by the
+ * single range flushes: L1 cleans, then the L2 operations, then L1
+ * invalidates. Each L1 pass is completed by one barrier rather than one per
+ * line. The entries were checked when decoding, so looking them up again in
+ * each pass cannot fail. */
+static exception_t performVSpaceFlushBatch(vspace_root_t *vspaceRoot, asid_t asid,
+                                           word_t numEntries, word_t *buffer)
 {
-    if (cap_frame_cap_get_capFMappedASID(cap) != 0) {
+    lookupFlushBatchEntry_ret_t e;
+    word_t i, unifyBytes = 0;
+    bool_t root_switched = false;
+    bool_t wholeICache;
+    vptr_t line;
 
-        unmapPage(cap_frame_cap_get_capFSize(cap),
-                  cap_frame_cap_get_capFMappedASID(cap),
+    if (!config_set(CONFIG_ARM_HYPERVISOR_SUPPORT)) {
+        root_switched = setVMRootForFlush(vspaceRoot, asid);
+    }
+
+    for (i = 0; i < numEntries; i++) {
+        e = lookupFlushBatchEntry(vspaceRoot, buffer, i);
+        if (e.empty) {
+            continue;
+        }
+        switch (e.op) {
+        case seL4_ARM_FlushBatch_Clean:
+        case seL4_ARM_FlushBatch_CleanInvalidate:
+            for (line = FLUSH_BATCH_LINE(e.start); line <= e.end; line += BIT(L1_CACHE_LINE_SIZE_BITS)) {
+                cleanByVA_nobarrier(line);
+            }
+            break;
+        case seL4_ARM_FlushBatch_Invalidate:
+            /* Clean partial lines at either end so that bytes outside the
+             * range are not discarded. */
+            if (e.start != FLUSH_BATCH_LINE(e.start)) {
+                cleanByVA_nobarrier(FLUSH_BATCH_LINE(e.start));
+            }
+            if (e.end + 1 != FLUSH_BATCH_LINE(e.end + 1)) {
+                cleanByVA_nobarrier(FLUSH_BATCH_LINE(e.end));
+            }
+            break;
+        case seL4_ARM_FlushBatch_Unify:
+            for (line = FLUSH_BATCH_LINE(e.start); line <= e.end; line += BIT(L1_CACHE_LINE_SIZE_BITS)) {
+                cleanByVA_PoU_nobarrier(line);
+            }
+            unifyBytes += e.end - e.start + 1;
+            break;
+        }
+    }
+    dsb();
+
+    for (i = 0; i < numEntries; i++) {
+        e = lookupFlushBatchEntry(vspaceRoot, buffer, i);
+        if (e.empty) {
+            continue;
+        }
+        switch (e.op) {
+        case seL4_ARM_FlushBatch_Clean:
+            plat_cleanL2Range(e.pstart, e.pstart + (e.end - e.start));
+            break;
+        case seL4_ARM_FlushBatch_Invalidate:
+            if (e.start != FLUSH_BATCH_LINE(e.start)) {
+                plat_cleanL2Range(e.pstart, e.pstart);
+            }
+            if (e.end + 1 != FLUSH_BATCH_LINE(e.end + 1)) {
+                line = FLUSH_BATCH_LINE(e.end);
+                plat_cleanL2Range(e.pstart + (line - e.start), e.pstart + (line - e.start));
+            }
+            plat_invalidateL2Range(e.pstart, e.pstart + (e.end - e.start));
+            break;
+        case seL4_ARM_FlushBatch_CleanInvalidate:
+            plat_cleanInvalidateL2Range(e.pstart, e.pstart + (e.end - e.start));
+            break;
+        }
+    }
+
+    /* Past the threshold, or where the lines of a VIPT instruction cache
+     * cannot be named through the kernel alias, the whole instruction cache
+     * is invalidated once instead. */
+    wholeICache = unifyBytes > CONFIG_ARM_CACHE_FLUSH_BATCH_ICACHE_THRESHOLD;
+#if defined(CONFIG_ARM_ICACHE_VIPT) && defined(CONFIG_ARM_HYPERVISOR_SUPPORT)
+    wholeICache = true;
+#endif
+
+    for (i = 0; i < numEntries; i++) {
+        e = lookupFlushBatchEntry(vspaceRoot, buffer, i);
+        if (e.empty) {
+            continue;
+        }
+        switch (e.op) {
+        case seL4_ARM_FlushBatch_Invalidate:
+            for (line = FLUSH_BATCH_LINE(e.start); line <= e.end; line += BIT(L1_CACHE_LINE_SIZE_BITS)) {
+                invalidateByVA_nobarrier(line);
+            }
+            break;
+        case seL4_ARM_FlushBatch_CleanInvalidate:
+            for (line = FLUSH_BATCH_LINE(e.start); line <= e.end; line += BIT(L1_CACHE_LINE_SIZE_BITS)) {
+                cleanInvalByVA_nobarrier(line);
+            }
+            break;
+        case seL4_ARM_FlushBatch_Unify:
+            if (!wholeICache) {
+                for (line = FLUSH_BATCH_LINE(e.start); line <= e.end; line += BIT(L1_CACHE_LINE_SIZE_BITS)) {
+                    invalidateByVA_I_nobarrier(line);
+                }
+            }
+            break;
+        }
+    }
+    if (unifyBytes != 0 && wholeICache) {
+        invalidate_I_PoU();
+    }
+    dsb();
+    if (unifyBytes != 0) {
+        isb();
+    }
+
+    if (root_switched) {
+        setVMRoot(NODE_STATE(ksCurThread));
+    }
+    return EXCEPTION_NONE;
+}
+#endif
+
+
+static exception_t performPageTableInvocationMap(cap_t cap, cte_t *ctSlot, pte_t pte, pte_t *ptSlot)
+{
+    ctSlot->cap = cap;
+    *ptSlot = pte;
+    cleanByVA_PoU((vptr_t)ptSlot, pptr_to_paddr(ptSlot));
+
+    return EXCEPTION_NONE;
+}
+
+static exception_t performPageTableInvocationUnmap(cap_t cap, cte_t *ctSlot)
+{
+    if (cap_page_table_cap_get_capPTIsMapped(cap)) {
+        pte_t *pt = PT_PTR(cap_page_table_cap_get_capPTBasePtr(cap));
+        unmapPageTable(cap_page_table_cap_get_capPTMappedASID(cap),
+                       cap_page_table_cap_get_capPTMappedAddress(cap), pt);
+        clearMemory_PT((void *)pt, cap_get_capSizeBits(cap));
+    }
+
+    cap_page_table_cap_ptr_set_capPTIsMapped(&(ctSlot->cap), 0);
+    return EXCEPTION_NONE;
+}
+
+static exception_t performPageInvocationMap(asid_t asid, cap_t cap, cte_t *ctSlot,
+                                            pte_t pte, pte_t *ptSlot)
+{
+    bool_t tlbflush_required = pte_ptr_get_valid(ptSlot);
+
+#ifdef CONFIG_ARM_CONTIGUOUS_HINT
+    breakContiguousGroup(asid, ptSlot);
+#endif
+    ctSlot->cap = cap;
+    *ptSlot = pte;
+
+    cleanByVA_PoU((vptr_t)ptSlot, pptr_to_paddr(ptSlot));
+    if (unlikely(tlbflush_required)) {
+        assert(asid < BIT(16));
+        invalidateTLBByASIDVA(asid, cap_frame_cap_get_capFMappedAddress(cap));
+    }
+#ifdef CONFIG_ARM_CONTIGUOUS_HINT
+    makeContiguousGroup(asid, ptSlot, pageBitsForSize(cap_frame_cap_get_capFSize(cap)));
+#endif
+
+    return EXCEPTION_NONE;
+}
+
+static exception_t performPageInvocationUnmap(cap_t cap, cte_t *ctSlot)
+{
+    if (cap_frame_cap_get_capFMappedASID(cap) != 0) {
+
+        unmapPage(cap_frame_cap_get_capFSize(cap),
+                  cap_frame_cap_get_capFMappedASID(cap),
                   cap_frame_cap_get_capFMappedAddress(cap),
                   cap_frame_cap_get_capFBasePtr(cap));
     }
@@ -1298,8 +1984,233 @@ static exception_t performASIDControlInvocation(void *frame, cte_t *slot,
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_ARM_VSPACE_RANGE
+/* A run of consecutive PTEs written by a range invocation whose cache lines
+ * have not been cleaned yet, and the first of the virtual addresses they
+ * translate. Cleaning the run at once cleans each cache line of PTEs once. */
+typedef struct pte_run {
+    pte_t *start;
+    pte_t *end;
+    vptr_t vaddr;
+    word_t pageBits;
+    bool_t flushTLB;
+} pte_run_t;
+
+static void flushPTERun(asid_t asid, pte_run_t *run)
+{
+    if (run->start == run->end) {
+        return;
+    }
+
+    cleanCacheRange_PoU((vptr_t)run->start, (vptr_t)run->end - 1, pptr_to_paddr(run->start));
+    if (run->flushTLB) {
+        assert(asid < BIT(16));
+        for (word_t i = 0; i < (word_t)(run->end - run->start); i++) {
+            invalidateTLBByASIDVA(asid, run->vaddr + (i << run->pageBits));
+        }
+    }
+    run->start = run->end;
+    run->flushTLB = false;
+}
+
+/* Write a PTE and add it to the run, first flushing the run if the PTE does
+ * not extend it. TLB entries only need invalidating if the old PTE was valid. */
+static void writePTERun(asid_t asid, pte_run_t *run, pte_t *ptSlot, pte_t pte, vptr_t vaddr,
+                        word_t pageBits)
+{
+    bool_t wasValid = pte_ptr_get_valid(ptSlot);
+
+    if (ptSlot != run->end || pageBits != run->pageBits ||
+        vaddr != run->vaddr + ((word_t)(run->end - run->start) << pageBits)) {
+        flushPTERun(asid, run);
+        run->start = ptSlot;
+        run->vaddr = vaddr;
+        run->pageBits = pageBits;
+    }
+    *ptSlot = pte;
+    run->end = ptSlot + 1;
+    run->flushTLB |= wasValid;
+}
+
+/* Find the slot for vaddr, reusing the slot found for the previous frame when
+ * vaddr directly follows it in the same table, so that a run of frames walks
+ * the page tables once per table. */
+static lookupPTSlot_ret_t lookupNextPTSlot(vspace_root_t *vspaceRoot, lookupPTSlot_ret_t prev,
+                                           vptr_t prevVaddr, vptr_t vaddr)
+{
+    if (prev.ptSlot != NULL && vaddr == prevVaddr + BIT(prev.ptBitsLeft) &&
+        ((vaddr >> prev.ptBitsLeft) & MASK(PT_INDEX_BITS)) != 0 &&
+        (prev.ptBitsLeft == seL4_PageBits || !pte_pte_table_ptr_get_present(prev.ptSlot + 1))) {
+        prev.ptSlot++;
+        return prev;
+    }
+    return lookupPTSlot(vspaceRoot, vaddr);
+}
+
+static exception_t performVSpaceMapRange(vspace_root_t *vspaceRoot, asid_t asid, cte_t *slots,
+                                         word_t count, vptr_t vaddr, seL4_CapRights_t rightsMask,
+                                         vm_attributes_t attributes, bool_t call)
+{
+    pte_run_t run = { NULL, NULL, 0, 0, false };
+    lookupPTSlot_ret_t lu_ret = { NULL, 0 };
+    vptr_t prevVaddr = 0;
+    exception_t status;
+    word_t i;
+
+    /* A restarted invocation finds the frames it has already mapped with the
+     * same PTE and goes past them without writing to the page tables. Only
+     * PTE writes are counted as work for preemption, so that a restart does
+     * not spend its work units again on those frames and every restart makes
+     * progress. */
+    for (i = 0; i < count; i++) {
+        cap_t cap = slots[i].cap;
+
+        if (cap_get_capType(cap) != cap_frame_cap) {
+            break;
+        }
+
+        vm_page_size_t frameSize = cap_frame_cap_get_capFSize(cap);
+        word_t frameBits = pageBitsForSize(frameSize);
+        asid_t frame_asid = cap_frame_cap_get_capFMappedASID(cap);
+
+        if (!IS_ALIGNED(vaddr, frameBits) || vaddr + MASK(frameBits) > USER_TOP) {
+            break;
+        }
+        if (frame_asid != asidInvalid &&
+            (frame_asid != asid || cap_frame_cap_get_capFMappedAddress(cap) != vaddr)) {
+            break;
+        }
+
+        lu_ret = lookupNextPTSlot(vspaceRoot, lu_ret, prevVaddr, vaddr);
+        if (lu_ret.ptBitsLeft != frameBits) {
+            break;
+        }
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+        if (isSharedPTLink(lu_ret.ptSlot)) {
+            break;
+        }
+#endif
+
+        pte_t pte = makeUserPagePTE(pptr_to_paddr((void *)cap_frame_cap_get_capFBasePtr(cap)),
+                                    maskVMRights(cap_frame_cap_get_capFVMRights(cap), rightsMask),
+                                    attributes, frameSize);
+        cap = cap_frame_cap_set_capFMappedASID(cap, asid);
+        slots[i].cap = cap_frame_cap_set_capFMappedAddress(cap, vaddr);
+        prevVaddr = vaddr;
+        vaddr += BIT(frameBits);
+
+#ifdef CONFIG_ARM_CONTIGUOUS_HINT
+        /* An entry already made part of a contiguous group still counts as
+         * the same mapping. */
+        pte_t old = *lu_ret.ptSlot;
+        if (pte_is_page_type(old)) {
+            old = pte_set_contiguous(old, false);
+        }
+        if (old.words[0] == pte.words[0]) {
+            continue;
+        }
+        breakContiguousGroup(asid, lu_ret.ptSlot);
+        writePTERun(asid, &run, lu_ret.ptSlot, pte, prevVaddr, frameBits);
+        makeContiguousGroup(asid, lu_ret.ptSlot, frameBits);
+#else
+        if (lu_ret.ptSlot->words[0] == pte.words[0]) {
+            continue;
+        }
+        writePTERun(asid, &run, lu_ret.ptSlot, pte, prevVaddr, frameBits);
+#endif
+
+        status = preemptionPoint();
+        if (status != EXCEPTION_NONE) {
+            flushPTERun(asid, &run);
+            return status;
+        }
+    }
+    flushPTERun(asid, &run);
+
+    if (call) {
+        tcb_t *thread = NODE_STATE(ksCurThread);
+        word_t *ipcBuffer = lookupIPCBuffer(true, thread);
+
+        setRegister(thread, badgeRegister, 0);
+        setRegister(thread, msgInfoRegister, wordFromMessageInfo(
+                        seL4_MessageInfo_new(0, 0, 0, setMR(thread, ipcBuffer, 0, i))));
+    }
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Running);
+
+    return EXCEPTION_NONE;
+}
+
+static exception_t performVSpaceUnmapRange(vspace_root_t *vspaceRoot, asid_t asid, cte_t *slots,
+                                           word_t count)
+{
+    pte_run_t run = { NULL, NULL, 0, 0, false };
+    lookupPTSlot_ret_t lu_ret = { NULL, 0 };
+    vptr_t prevVaddr = 0;
+    exception_t status;
+
+    for (word_t i = 0; i < count; i++) {
+        cap_t cap = slots[i].cap;
+
+        if (cap_get_capType(cap) == cap_frame_cap && cap_frame_cap_get_capFMappedASID(cap) == asid) {
+            vptr_t vaddr = cap_frame_cap_get_capFMappedAddress(cap);
+            word_t frameBits = pageBitsForSize(cap_frame_cap_get_capFSize(cap));
+
+            /* As in unmapPage, a stale mapping is left alone but the cap is
+             * still marked unmapped. */
+            lu_ret = lookupNextPTSlot(vspaceRoot, lu_ret, prevVaddr, vaddr);
+            prevVaddr = vaddr;
+            if (lu_ret.ptBitsLeft == frameBits && pte_is_page_type(*lu_ret.ptSlot) &&
+                pte_get_page_base_address(*lu_ret.ptSlot) ==
+                pptr_to_paddr((void *)cap_frame_cap_get_capFBasePtr(cap))) {
+#ifdef CONFIG_ARM_CONTIGUOUS_HINT
+                breakContiguousGroup(asid, lu_ret.ptSlot);
+#endif
+                writePTERun(asid, &run, lu_ret.ptSlot, pte_pte_invalid_new(), vaddr, frameBits);
+            }
+
+            cap = cap_frame_cap_set_capFMappedAddress(cap, 0);
+            slots[i].cap = cap_frame_cap_set_capFMappedASID(cap, asidInvalid);
+
+            /* Caps unmapped before a restart are skipped without counting
+             * as work, as in performVSpaceMapRange. */
+            status = preemptionPoint();
+            if (status != EXCEPTION_NONE) {
+                flushPTERun(asid, &run);
+                return status;
+            }
+        }
+    }
+    flushPTERun(asid, &run);
+
+    return EXCEPTION_NONE;
+}
+
+/* Resolve the slots of a range invocation, which must all lie in the CNode
+ * itself rather than anywhere in the CSpace below it. */
+static cte_t *decodeVSpaceRangeSlots(cap_t cnodeCap, word_t first, word_t count)
+{
+    if (unlikely(cap_get_capType(cnodeCap) != cap_cnode_cap)) {
+        userError("VSpace Range: Invalid CNode cap.");
+        current_syscall_error.type = seL4_InvalidCapability;
+        current_syscall_error.invalidCapNumber = 1;
+        return NULL;
+    }
+
+    word_t slots = BIT(cap_cnode_cap_get_capCNodeRadix(cnodeCap));
+    if (unlikely(count == 0 || first >= slots || count > slots - first)) {
+        userError("VSpace Range: Invalid range of slots.");
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 1;
+        current_syscall_error.rangeErrorMax = first < slots ? slots - first : 0;
+        return NULL;
+    }
+
+    return CTE_PTR(cap_cnode_cap_get_capCNodePtr(cnodeCap)) + first;
+}
+#endif /* CONFIG_ARM_VSPACE_RANGE */
+
 static exception_t decodeARMVSpaceRootInvocation(word_t invLabel, word_t length,
-                                                 cte_t *cte, cap_t cap, word_t *buffer)
+                                                 cte_t *cte, cap_t cap, bool_t call, word_t *buffer)
 {
     vptr_t start, end;
     paddr_t pstart;
@@ -1406,6 +2317,113 @@ static exception_t decodeARMVSpaceRootInvocation(word_t invLabel, word_t length,
         setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
         return performVSpaceFlush(invLabel, vspaceRoot, asid, start, end - 1, pstart);
 
+#ifdef CONFIG_ARM_VSPACE_RANGE
+    case ARMVSpaceMapRange:
+    case ARMVSpaceUnmapRange: {
+        word_t minLength = invLabel == ARMVSpaceMapRange ? 5 : 2;
+        cte_t *slots;
+
+        if (unlikely(length < minLength || current_extra_caps.excaprefs[0] == NULL)) {
+            userError("VSpace Range: Truncated message.");
+            current_syscall_error.type = seL4_TruncatedMessage;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        if (unlikely(!isValidNativeRoot(cap))) {
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 0;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        vspaceRoot = VSPACE_PTR(cap_vspace_cap_get_capVSBasePtr(cap));
+        asid = cap_vspace_cap_get_capVSMappedASID(cap);
+
+        find_ret = findVSpaceForASID(asid);
+        if (unlikely(find_ret.status != EXCEPTION_NONE)) {
+            userError("VSpace Range: No VSpace for ASID");
+            current_syscall_error.type = seL4_FailedLookup;
+            current_syscall_error.failedLookupWasSource = false;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        if (unlikely(find_ret.vspace_root != vspaceRoot)) {
+            userError("VSpace Range: Invalid VSpace Cap");
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 0;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        slots = decodeVSpaceRangeSlots(current_extra_caps.excaprefs[0]->cap,
+                                       getSyscallArg(0, buffer), getSyscallArg(1, buffer));
+        if (unlikely(slots == NULL)) {
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+        if (invLabel == ARMVSpaceUnmapRange) {
+            return performVSpaceUnmapRange(vspaceRoot, asid, slots, getSyscallArg(1, buffer));
+        }
+        return performVSpaceMapRange(vspaceRoot, asid, slots, getSyscallArg(1, buffer),
+                                     getSyscallArg(2, buffer), rightsFromWord(getSyscallArg(3, buffer)),
+                                     vmAttributesFromWord(getSyscallArg(4, buffer)), call);
+    }
+#endif
+
+#ifdef CONFIG_ARM_CACHE_FLUSH_BATCH
+    case ARMVSpaceFlushBatch: {
+        word_t numEntries, i;
+
+        if (unlikely(length < 1 || buffer == NULL)) {
+            userError("VSpaceRoot FlushBatch: Truncated message.");
+            current_syscall_error.type = seL4_TruncatedMessage;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        numEntries = getSyscallArg(0, buffer);
+        if (unlikely(numEntries < 1 || numEntries > seL4_ARM_FlushBatchMaxEntries)) {
+            userError("VSpaceRoot FlushBatch: Number of entries (%d) too small or large.", (int)numEntries);
+            current_syscall_error.type = seL4_RangeError;
+            current_syscall_error.rangeErrorMin = 1;
+            current_syscall_error.rangeErrorMax = seL4_ARM_FlushBatchMaxEntries;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        if (unlikely(!isValidNativeRoot(cap))) {
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 0;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        vspaceRoot = VSPACE_PTR(cap_vspace_cap_get_capVSBasePtr(cap));
+        asid = cap_vspace_cap_get_capVSMappedASID(cap);
+
+        find_ret = findVSpaceForASID(asid);
+        if (unlikely(find_ret.status != EXCEPTION_NONE)) {
+            userError("VSpaceRoot FlushBatch: No VSpace for ASID");
+            current_syscall_error.type = seL4_FailedLookup;
+            current_syscall_error.failedLookupWasSource = false;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        if (unlikely(find_ret.vspace_root != vspaceRoot)) {
+            userError("VSpaceRoot FlushBatch: Invalid VSpace Cap");
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 0;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        /* Check every entry before performing any of them. */
+        for (i = 0; i < numEntries; i++) {
+            if (lookupFlushBatchEntry(vspaceRoot, buffer, i).status != EXCEPTION_NONE) {
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+        }
+
+        setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+        return performVSpaceFlushBatch(vspaceRoot, asid, numEntries, buffer);
+    }
+#endif
+
     default:
         current_syscall_error.type = seL4_IllegalOperation;
         return EXCEPTION_SYSCALL_ERROR;
@@ -1413,6 +2431,166 @@ static exception_t decodeARMVSpaceRootInvocation(word_t invLabel, word_t length,
 }
 
 
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+/* Find the slot in vspace through which target_pt is mapped at vptr. */
+static lookupPTSlot_ret_t lookupPTLink(vspace_root_t *vspace, vptr_t vptr, pte_t *target_pt)
+{
+    lookupPTSlot_ret_t ret;
+    word_t level = UPT_LEVELS - 1;
+    pte_t *pt;
+
+    ret.ptBitsLeft = PT_INDEX_BITS * level + seL4_PageBits;
+    ret.ptSlot = vspace + ((vptr >> ret.ptBitsLeft) & MASK(seL4_VSpaceIndexBits));
+
+    while (pte_pte_table_ptr_get_present(ret.ptSlot) && likely(level > 0)) {
+        pt = paddr_to_pptr(pte_pte_table_ptr_get_pt_base_address(ret.ptSlot));
+        if (pt == target_pt) {
+            return ret;
+        }
+        level--;
+        ret.ptBitsLeft -= PT_INDEX_BITS;
+        ret.ptSlot = pt + ((vptr >> ret.ptBitsLeft) & MASK(PT_INDEX_BITS));
+    }
+
+    ret.ptSlot = NULL;
+    return ret;
+}
+
+static exception_t performPageTableInvocationMapShared(cap_t cap, cte_t *ctSlot, shared_pt_t *spt,
+                                                       asid_t asid, pte_t *ptSlot, cte_t *destSlot)
+{
+    pte_t *pt = PTE_PTR(cap_page_table_cap_get_capPTBasePtr(cap));
+    pte_t pte = pte_pte_table_new(
+                    1, /* no_write */
+                    1, /* shared */
+                    pptr_to_paddr(pt));
+
+    if (spt->pt == NULL) {
+        spt->pt = pt;
+        spt->vaddr = cap_page_table_cap_get_capPTMappedAddress(cap);
+        spt->owner = cap_page_table_cap_get_capPTMappedASID(cap);
+        spt->sharers = 0;
+        armKSNumSharedPTs++;
+    }
+    spt->sharers++;
+
+    *ptSlot = pte;
+    cleanByVA_PoU((vptr_t)ptSlot, pptr_to_paddr(ptSlot));
+
+    cap = cap_page_table_cap_set_capPTIsShared(cap, 1);
+    cap = cap_page_table_cap_set_capPTMappedASID(cap, asid);
+    cteInsert(cap, ctSlot, destSlot);
+
+    return EXCEPTION_NONE;
+}
+
+static exception_t decodeARMPageTableMapShared(word_t length, cte_t *cte, cap_t cap, word_t *buffer)
+{
+    cap_t vspaceRootCap;
+    vspace_root_t *vspaceRoot;
+    asid_t asid, owner;
+    vptr_t vaddr;
+    pte_t *pt;
+    lookupPTSlot_ret_t link, ptSlot;
+    findVSpaceForASID_ret_t find_ret;
+    lookupSlot_ret_t lu_ret;
+    shared_pt_t *spt;
+    exception_t status;
+
+    if (unlikely(length < 2 || current_extra_caps.excaprefs[0] == NULL ||
+                 current_extra_caps.excaprefs[1] == NULL)) {
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (unlikely(!cap_page_table_cap_get_capPTIsMapped(cap) || cap_page_table_cap_get_capPTIsShared(cap))) {
+        userError("ARMPageTableMapShared: Only a page table mapped by its owner can be shared.");
+        current_syscall_error.type = seL4_InvalidCapability;
+        current_syscall_error.invalidCapNumber = 0;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    pt = PTE_PTR(cap_page_table_cap_get_capPTBasePtr(cap));
+    owner = cap_page_table_cap_get_capPTMappedASID(cap);
+    vaddr = cap_page_table_cap_get_capPTMappedAddress(cap);
+
+    find_ret = findVSpaceForASID(owner);
+    if (unlikely(find_ret.status != EXCEPTION_NONE)) {
+        current_syscall_error.type = seL4_FailedLookup;
+        current_syscall_error.failedLookupWasSource = true;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    link = lookupPTLink(find_ret.vspace_root, vaddr, pt);
+    spt = findSharedPT(pt);
+    if (unlikely(link.ptSlot == NULL || pte_pte_table_ptr_get_shared(link.ptSlot) ||
+                 (spt != NULL && spt->owner != owner))) {
+        userError("ARMPageTableMapShared: The page table is no longer mapped by its owner.");
+        current_syscall_error.type = seL4_FailedLookup;
+        current_syscall_error.failedLookupWasSource = true;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    vspaceRootCap = current_extra_caps.excaprefs[0]->cap;
+    if (unlikely(!isValidNativeRoot(vspaceRootCap))) {
+        current_syscall_error.type = seL4_InvalidCapability;
+        current_syscall_error.invalidCapNumber = 1;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    vspaceRoot = VSPACE_PTR(cap_vspace_cap_get_capVSBasePtr(vspaceRootCap));
+    asid = cap_vspace_cap_get_capVSMappedASID(vspaceRootCap);
+
+    find_ret = findVSpaceForASID(asid);
+    if (unlikely(find_ret.status != EXCEPTION_NONE)) {
+        current_syscall_error.type = seL4_FailedLookup;
+        current_syscall_error.failedLookupWasSource = false;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (unlikely(find_ret.vspace_root != vspaceRoot)) {
+        current_syscall_error.type = seL4_InvalidCapability;
+        current_syscall_error.invalidCapNumber = 1;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    /* The link goes at the same address and level as the owner's. */
+    ptSlot = lookupPTSlot(vspaceRoot, vaddr);
+    if (unlikely(ptSlot.ptBitsLeft > link.ptBitsLeft)) {
+        current_lookup_fault = lookup_fault_missing_capability_new(ptSlot.ptBitsLeft);
+        current_syscall_error.type = seL4_FailedLookup;
+        current_syscall_error.failedLookupWasSource = false;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    if (unlikely(ptSlot.ptBitsLeft != link.ptBitsLeft || pte_ptr_get_valid(ptSlot.ptSlot))) {
+        current_syscall_error.type = seL4_DeleteFirst;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (spt == NULL) {
+        spt = findSharedPT(NULL);
+        if (unlikely(spt == NULL)) {
+            userError("ARMPageTableMapShared: No free shared page table entries.");
+            current_syscall_error.type = seL4_DeleteFirst;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+    }
+
+    lu_ret = lookupTargetSlot(current_extra_caps.excaprefs[1]->cap,
+                              getSyscallArg(0, buffer), getSyscallArg(1, buffer));
+    if (unlikely(lu_ret.status != EXCEPTION_NONE)) {
+        return lu_ret.status;
+    }
+
+    status = ensureEmptySlot(lu_ret.slot);
+    if (unlikely(status != EXCEPTION_NONE)) {
+        return status;
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return performPageTableInvocationMapShared(cap, cte, spt, asid, ptSlot.ptSlot, lu_ret.slot);
+}
+#endif
+
 static exception_t decodeARMPageTableInvocation(word_t invLabel, word_t length,
                                                 cte_t *cte, cap_t cap, word_t *buffer)
 {
@@ -1425,6 +2603,13 @@ static exception_t decodeARMPageTableInvocation(word_t invLabel, word_t length,
     findVSpaceForASID_ret_t find_ret;
 
     if (invLabel == ARMPageTableUnmap) {
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+        if (unlikely(cap_page_table_cap_get_capPTIsShared(cap))) {
+            userError("ARMPageTableUnmap: A shared page table is unmapped by deleting its cap.");
+            current_syscall_error.type = seL4_IllegalOperation;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+#endif
         if (unlikely(!isFinalCapability(cte))) {
             current_syscall_error.type = seL4_RevokeFirst;
             return EXCEPTION_SYSCALL_ERROR;
@@ -1434,6 +2619,12 @@ static exception_t decodeARMPageTableInvocation(word_t invLabel, word_t length,
         return performPageTableInvocationUnmap(cap, cte);
     }
 
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+    if (invLabel == ARMPageTableMapShared) {
+        return decodeARMPageTableMapShared(length, cte, cap, buffer);
+    }
+#endif
+
     if (unlikely(invLabel != ARMPageTableMap)) {
         current_syscall_error.type = seL4_IllegalOperation;
         return EXCEPTION_SYSCALL_ERROR;
@@ -1488,7 +2679,12 @@ static exception_t decodeARMPageTableInvocation(word_t invLabel, word_t length,
         return EXCEPTION_SYSCALL_ERROR;
     }
 
-    pte = pte_pte_table_new(pptr_to_paddr(PTE_PTR(cap_page_table_cap_get_capPTBasePtr(cap))));
+    pte = pte_pte_table_new(
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+              0, /* no_write */
+              0, /* shared */
+#endif
+              pptr_to_paddr(PTE_PTR(cap_page_table_cap_get_capPTBasePtr(cap))));
 
     cap = cap_page_table_cap_set_capPTIsMapped(cap, 1);
     cap = cap_page_table_cap_set_capPTMappedASID(cap, asid);
@@ -1594,6 +2790,12 @@ static exception_t decodeARMFrameInvocation(word_t invLabel, word_t length,
             current_syscall_error.failedLookupWasSource = false;
             return EXCEPTION_SYSCALL_ERROR;
         }
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+        if (unlikely(isSharedPTLink(lu_ret.ptSlot))) {
+            current_syscall_error.type = seL4_DeleteFirst;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+#endif
 
         setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
         return performPageInvocationMap(asid, cap, cte,
@@ -1707,7 +2909,7 @@ exception_t decodeARMMMUInvocation(word_t invLabel, word_t length, cptr_t cptr,
 {
     switch (cap_get_capType(cap)) {
     case cap_vspace_cap:
-        return decodeARMVSpaceRootInvocation(invLabel, length, cte, cap, buffer);
+        return decodeARMVSpaceRootInvocation(invLabel, length, cte, cap, call, buffer);
     case cap_page_table_cap:
         return decodeARMPageTableInvocation(invLabel, length, cte, cap, buffer);
 
@@ -1989,6 +3191,7 @@ exception_t benchmark_arch_map_logBuffer(word_t frame_cptr)
 #else
                              1, // UXN
 #endif
+                             0,                         /* contiguous */
                              ksUserLogBuffer,
                              0,                         /* global */
                              1,                         /* access flag */
@@ -20,6 +20,11 @@
 
 asid_pool_t *armKSASIDTable[nASIDPools];
 
+#ifdef CONFIG_KERNEL_ARCH_CLEAR_MEMORY
+/* log2 of the DC ZVA block size in bytes, or 0 if DC ZVA may not be used */
+word_t armKSZeroBlockBits;
+#endif
+
 /* AArch64 Memory map explanation:
  *
  * EL1 and EL2 kernel build vaddrspace layouts:
@@ -101,6 +106,19 @@ compile_assert(log_pde_is_correct_preallocated_pde,
 UP_STATE_DEFINE(vcpu_t, *armHSCurVCPU);
 UP_STATE_DEFINE(bool_t, armHSVCPUActive);
 
+#ifdef CONFIG_ARM_VMID_GENERATIONS
+UP_STATE_DEFINE(word_t, armKSVMIDCoreGeneration);
+UP_STATE_DEFINE(asid_t, armKSActiveASID);
+UP_STATE_DEFINE(hw_asid_t, armKSActiveVMID);
+
+/* VMIDs handed out in the current generation, one bit per VMID. The
+ * number of usable VMIDs (8 or 16 bits) is discovered at boot.
+ */
+word_t armKSVMIDBitmap[BIT(VMID_MAX_BITS) / wordBits];
+word_t armKSVMIDBits;
+word_t armKSVMIDGeneration;
+word_t armKSNextVMID;
+#else
 /* The hardware VMID to virtual ASID mapping table.
  * The ARMv8 supports 8-bit VMID which is used as logical ASID
  * when the kernel runs in EL2.
@@ -108,6 +126,14 @@ UP_STATE_DEFINE(bool_t, armHSVCPUActive);
 asid_t armKSHWASIDTable[BIT(hwASIDBits)];
 hw_asid_t armKSNextASID;
 #endif
+#endif
+
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+/* Page tables linked into more than one VSpace, and how many entries of the
+ * table are in use so that TLB maintenance can skip searching it. */
+shared_pt_t armKSSharedPTs[CONFIG_ARM_MAX_SHARED_PAGE_TABLES];
+word_t armKSNumSharedPTs;
+#endif
 
 #ifdef CONFIG_ARM_SMMU
 /*recording the state of created SID caps*/
@@ -45,6 +45,16 @@ deriveCap_ret_t Arch_deriveCap(cte_t *slot, cap_t cap)
         return ret;
 
     case cap_page_table_cap:
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+        /* Each link to a shared page table has exactly one cap. */
+        if (cap_page_table_cap_get_capPTIsShared(cap)) {
+            userError("Deriving a shared PT cap");
+            current_syscall_error.type = seL4_IllegalOperation;
+            ret.cap = cap_null_cap_new();
+            ret.status = EXCEPTION_SYSCALL_ERROR;
+            return ret;
+        }
+#endif
         if (cap_page_table_cap_get_capPTIsMapped(cap)) {
             ret.cap = cap;
             ret.status = EXCEPTION_NONE;
@@ -162,6 +172,12 @@ finaliseCap_ret_t Arch_finaliseCap(cap_t cap, bool_t final)
         break;
 
     case cap_page_table_cap:
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+        if (cap_page_table_cap_get_capPTIsShared(cap)) {
+            unmapSharedPageTable(cap, final);
+            break;
+        }
+#endif
         if (final && cap_page_table_cap_get_capPTIsMapped(cap)) {
             unmapPageTable(cap_page_table_cap_get_capPTMappedASID(cap),
                            cap_page_table_cap_get_capPTMappedAddress(cap),
@@ -476,6 +492,9 @@ cap_t Arch_createObject(object_t t, void *regionBase, word_t userSize, bool_t de
         return cap_page_table_cap_new(
                    asidInvalid,           /* capPTMappedASID    */
                    (word_t)regionBase,    /* capPTBasePtr       */
+#ifdef CONFIG_ARM_SHARED_PAGE_TABLES
+                   0,                     /* capPTIsShared      */
+#endif
                    0,                     /* capPTIsMapped      */
                    0                      /* capPTMappedAddress */
                );
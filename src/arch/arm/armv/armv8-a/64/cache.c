@@ -4,7 +4,11 @@
  * SPDX-License-Identifier: GPL-2.0-only
  */
 
+#include <config.h>
+#include <linker.h>
+#include <arch/machine.h>
 #include <arch/machine/hardware.h>
+#include <arch/model/statedata.h>
 
 static inline void cleanByWSL(word_t wsl)
 {
@@ -106,3 +110,32 @@ void cleanInvalidate_L1D(void)
 {
     cleanInvalidate_D_by_level(0);
 }
+
+#ifdef CONFIG_KERNEL_ARCH_CLEAR_MEMORY
+BOOT_CODE void initClearMemory(void)
+{
+    word_t dczid;
+
+    MRS("dczid_el0", dczid);
+    /* DZP set means DC ZVA is prohibited, BS is log2 of the block size in words */
+    if (dczid & BIT(4)) {
+        armKSZeroBlockBits = 0;
+    } else {
+        armKSZeroBlockBits = (dczid & MASK(4)) + 2;
+    }
+}
+
+void clearMemory_ZVA(void *ptr, word_t n)
+{
+    word_t bits = armKSZeroBlockBits;
+
+    if (bits == 0 || !IS_ALIGNED((word_t)ptr, bits) || !IS_ALIGNED(n, bits)) {
+        memzero(ptr, n);
+        return;
+    }
+
+    for (word_t p = (word_t)ptr; p < (word_t)ptr + n; p += BIT(bits)) {
+        asm volatile("dc zva, %0" :: "r"(p) : "memory");
+    }
+}
+#endif /* CONFIG_KERNEL_ARCH_CLEAR_MEMORY */
@@ -208,6 +208,82 @@ config_option(
 )
 mark_as_advanced(KernelAArch64SErrorIgnore)
 
+config_option(
+    KernelArmContiguousHint ARM_CONTIGUOUS_HINT
+    "Set the contiguous bit on user mappings when a naturally aligned group of 16 \
+    page table entries maps a physically contiguous 64KiB or 32MiB region with \
+    identical attributes, so that the group can be held in a single TLB entry. \
+    The bit is cleared again, with a break-before-make sequence, before any entry \
+    of the group is changed. The group is briefly invalid during that sequence, \
+    so the option is only available where nothing else can walk the page tables \
+    meanwhile: on single-core builds without SMMU support."
+    DEFAULT OFF
+    DEPENDS "KernelSel4ArchAarch64;NOT KernelMaxNumNodes GREATER 1;NOT KernelArmSMMU;NOT KernelVerificationBuild"
+)
+
+config_option(
+    KernelArmVSpaceRange ARM_VSPACE_RANGE
+    "Enable seL4_ARM_VSpace_MapRange and seL4_ARM_VSpace_UnmapRange, which map or unmap \
+    the frames held in a run of slots of one CNode in a single preemptible invocation. \
+    Page tables are walked once per table and page table entries are cleaned to the \
+    point of unification in batches of whole cache lines."
+    DEFAULT OFF
+    DEPENDS "KernelSel4ArchAarch64;NOT KernelVerificationBuild"
+)
+
+config_option(
+    KernelArmCacheFlushBatch ARM_CACHE_FLUSH_BATCH
+    "Enable seL4_ARM_VSpace_FlushBatch, which performs a list of cache maintenance \
+    operations on ranges of one VSpace in a single invocation. The operations on \
+    each cache level are issued for all ranges before a single barrier completes \
+    them, instead of one invocation and barrier per range."
+    DEFAULT OFF
+    DEPENDS "KernelSel4ArchAarch64;NOT KernelVerificationBuild"
+)
+
+config_string(
+    KernelArmCacheFlushBatchICacheThreshold ARM_CACHE_FLUSH_BATCH_ICACHE_THRESHOLD
+    "When the ranges of one seL4_ARM_VSpace_FlushBatch invocation that are unified \
+    add up to more than this many bytes, the whole instruction cache is invalidated \
+    instead of one line at a time. Data cache operations are always issued by \
+    address, as operations by set and way only affect the local core and are not \
+    suitable for keeping memory coherent with devices."
+    DEFAULT 65536
+    DEPENDS "KernelArmCacheFlushBatch" DEFAULT_DISABLED 0
+    UNQUOTE
+)
+
+config_option(
+    KernelArmSharedPageTables ARM_SHARED_PAGE_TABLES
+    "Enable seL4_ARM_PageTable_MapShared, which links a mapped page table into further \
+    VSpaces at the same address and level, so that identical read-only regions share \
+    their translation tables. The sharing VSpaces can only read through the shared \
+    table and cannot map anything into it. While page tables of a VSpace are shared, \
+    TLB maintenance for that VSpace invalidates the entries of every address space."
+    DEFAULT OFF
+    DEPENDS "KernelSel4ArchAarch64;NOT KernelArmHypervisorSupport;NOT KernelArmSMMU;NOT KernelVerificationBuild"
+)
+
+config_string(
+    KernelArmMaxSharedPageTables ARM_MAX_SHARED_PAGE_TABLES
+    "Maximum number of page tables that can be shared at the same time. Each one is \
+    tracked with its owner and a count of the VSpaces sharing it."
+    DEFAULT 64
+    DEPENDS "KernelArmSharedPageTables" DEFAULT_DISABLED 0
+    UNQUOTE
+)
+
+config_option(
+    KernelArmVMIDGenerations ARM_VMID_GENERATIONS
+    "Allocate the VMIDs that tag stage 2 translations in hypervisor mode with a \
+    generation-based allocator. 16-bit VMIDs are used when the processor supports \
+    them. Running out of VMIDs starts a new generation instead of evicting and \
+    flushing a single VMID: the VMIDs live on each core are kept and every core \
+    performs one local TLB flush before it next switches address space."
+    DEFAULT OFF
+    DEPENDS "KernelSel4ArchAarch64;KernelArmHypervisorSupport;NOT KernelArmSMMU;NOT KernelVerificationBuild"
+)
+
 config_option(
     KernelAllowSMCCalls ALLOW_SMC_CALLS "Allow components to make SMC calls. \
     WARNING: Allowing SMC calls causes a couple of issues. Since seL4 cannot \
@@ -220,6 +220,9 @@ BOOT_CODE static bool_t init_cpu(void)
 #ifdef CONFIG_ARCH_AARCH64
     /* initialise CPU's exception vector table */
     setVtable((pptr_t)arm_vector_table);
+#ifdef CONFIG_KERNEL_ARCH_CLEAR_MEMORY
+    initClearMemory();
+#endif
 #endif /* CONFIG_ARCH_AARCH64 */
 
     haveHWFPU = fpsimd_HWCapTest();
@@ -414,6 +417,17 @@ static BOOT_CODE bool_t try_init_kernel(
 
     /* The region of the initial thread is the user image + ipcbuf and boot info */
     word_t extra_bi_size_bits = calculate_extra_bi_size_bits(extra_bi_size);
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+    /* The extra bootinfo is allocated aligned to its size, so it can be mapped
+     * with large frames if it is at least a large page in size and its virtual
+     * address is aligned. It must directly follow the bootinfo frame, so the
+     * IPC buffer and bootinfo frame are moved up to make room. */
+    if (extra_bi_size_bits >= seL4_LargePageBits) {
+        extra_bi_frame_vptr = ROUND_UP(extra_bi_frame_vptr, seL4_LargePageBits);
+        bi_frame_vptr = extra_bi_frame_vptr - BIT(seL4_BootInfoFrameBits);
+        ipcbuf_vptr = bi_frame_vptr - BIT(PAGE_BITS);
+    }
+#endif
     v_region_t it_v_reg = {
         .start = ui_v_reg.start,
         .end   = extra_bi_frame_vptr + (extra_bi_size_bits > 0 ? BIT(extra_bi_size_bits) : 0)
@@ -429,6 +443,16 @@ static BOOT_CODE bool_t try_init_kernel(
         return false;
     }
 
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+    add_it_large_region(ui_v_reg, pv_offset);
+    if (extra_bi_size_bits >= seL4_LargePageBits) {
+        add_it_large_region((v_region_t) {
+            .start = extra_bi_frame_vptr,
+            .end   = extra_bi_frame_vptr + extra_bi_size
+        }, 0 /* congruent, as both addresses are aligned */);
+    }
+#endif
+
     if (!arch_init_freemem(ui_p_reg, dtb_p_reg, it_v_reg, extra_bi_size_bits)) {
         printf("ERROR: free memory management initialization failed\n");
         return false;
@@ -522,6 +546,9 @@ static BOOT_CODE bool_t try_init_kernel(
             return false;
         }
         ndks_boot.bi_frame->extraBIPages = extra_bi_ret.region;
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+        ndks_boot.bi_frame->extraBILargePages = extra_bi_ret.large;
+#endif
     }
 
 #ifdef CONFIG_KERNEL_MCS
@@ -549,6 +576,9 @@ static BOOT_CODE bool_t try_init_kernel(
         return false;
     }
     ndks_boot.bi_frame->userImageFrames = create_frames_ret.region;
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+    ndks_boot.bi_frame->userImageLargeFrames = create_frames_ret.large;
+#endif
 
     /* create/initialise the initial thread's ASID pool */
     it_ap_cap = create_it_asid_pool(root_cnode_cap);
@@ -37,6 +37,30 @@ config_option(
     DEPENDS "KernelArchRiscV"
 )
 
+config_option(
+    KernelRiscvExtZicboz RISCV_EXT_ZICBOZ
+    "RISC-V extension for cache-block zero instructions. The cbo.zero block size must be \
+    the L1 cache line size, and M-mode firmware must enable cbo.zero for S-mode."
+    DEFAULT OFF
+    DEPENDS "KernelArchRiscV"
+)
+
+config_option(
+    KernelRiscvExtSvinval RISCV_EXT_SVINVAL
+    "RISC-V extension for fine-grained address-translation cache invalidation. Page and ASID \
+    invalidations use sinval.vma between a single sfence.w.inval and sfence.inval.ir."
+    DEFAULT OFF
+    DEPENDS "KernelArchRiscV;NOT KernelVerificationBuild"
+)
+
+config_option(
+    KernelRiscvExtSvnapot RISCV_EXT_SVNAPOT
+    "RISC-V extension for NAPOT translation contiguity. Adds the seL4_RISCV_64K_Page frame \
+    object, mapped with 16 contiguous NAPOT page table entries."
+    DEFAULT OFF
+    DEPENDS "KernelSel4ArchRiscV64;NOT KernelVerificationBuild"
+)
+
 config_option(
     KernelRiscvUseClintMtime
     RISCV_USE_CLINT_MTIME
@@ -55,6 +55,18 @@ static inline bool_t isPTEPageTable(pte_t *pte)
            !(pte_ptr_get_read(pte) || pte_ptr_get_write(pte) || pte_ptr_get_execute(pte));
 }
 
+/* Size of the virtual region covered by one PTE of a frame of the given size,
+ * which is the page table level the frame is mapped at. */
+static inline word_t CONST pageLevelBitsForSize(vm_page_size_t size)
+{
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    if (size == RISCV_64K_Page) {
+        return seL4_PageBits;
+    }
+#endif
+    return pageBitsForSize(size);
+}
+
 /** Helper function meant only to be used for mapping the kernel
  * window.
  *
@@ -310,7 +322,7 @@ BOOT_CODE void activate_kernel_vspace(void)
 BOOT_CODE void write_it_asid_pool(cap_t it_ap_cap, cap_t it_lvl1pt_cap)
 {
     asid_pool_t *ap = ASID_POOL_PTR(pptr_of_cap(it_ap_cap));
-    ap->array[ASID_LOW(IT_ASID)] = PTE_PTR(pptr_of_cap(it_lvl1pt_cap));
+    asid_pool_set_vspace_root(ap, ASID_LOW(IT_ASID), PTE_PTR(pptr_of_cap(it_lvl1pt_cap)));
     riscvKSASIDTable[ASID_HIGH(IT_ASID)] = ap;
 }
 
@@ -331,7 +343,7 @@ static findVSpaceForASID_ret_t findVSpaceForASID(asid_t asid)
         return ret;
     }
 
-    vspace_root = poolPtr->array[ASID_LOW(asid)];
+    vspace_root = asid_pool_get_vspace_root(poolPtr, ASID_LOW(asid));
     if (!vspace_root) {
         current_lookup_fault = lookup_fault_invalid_root_new();
 
@@ -486,19 +498,63 @@ static exception_t performASIDPoolInvocation(asid_t asid, asid_pool_t *poolPtr,
 
     copyGlobalMappings(regionBase);
 
-    poolPtr->array[ASID_LOW(asid)] = regionBase;
+    asid_pool_set_vspace_root(poolPtr, ASID_LOW(asid), regionBase);
 
     return EXCEPTION_NONE;
 }
 
+/* Make a page table update in the VSpace with the given ASID visible. On SMP
+ * only the cores that have run with the ASID are asked to flush. */
+static void flushASID(asid_t asid)
+{
+#ifdef ENABLE_SMP_SUPPORT
+    asid_pool_t *poolPtr = riscvKSASIDTable[ASID_HIGH(asid)];
+
+    if (likely(poolPtr != NULL)) {
+        hwASIDFlushCores(asid, asid_pool_get_hart_mask(poolPtr, ASID_LOW(asid)));
+        return;
+    }
+#endif
+    sfence();
+}
+
+#ifdef CONFIG_RISCV_EXT_SVINVAL
+/* Flush n pages of size BIT(pageBits) starting at vaddr. The local
+ * invalidations are batched between a single pair of fences and remote harts
+ * are only asked to flush the affected range. */
+static void flushPages(asid_t asid, vptr_t vaddr, word_t n, word_t pageBits)
+{
+#ifdef ENABLE_SMP_SUPPORT
+    asid_pool_t *poolPtr = riscvKSASIDTable[ASID_HIGH(asid)];
+
+    if (unlikely(poolPtr == NULL)) {
+        sfence();
+        return;
+    }
+    fence_w_rw();
+    hwPagesFlushLocal(asid, vaddr, n, pageBits);
+    word_t mask = get_sbi_mask_for_remote_harts(asid_pool_get_hart_mask(poolPtr, ASID_LOW(asid)));
+    if (mask != 0) {
+        sbi_remote_sfence_vma_asid(mask, vaddr, n << pageBits, asid);
+    }
+#else
+    hwPagesFlushLocal(asid, vaddr, n, pageBits);
+#endif
+}
+#endif /* CONFIG_RISCV_EXT_SVINVAL */
+
 void deleteASID(asid_t asid, pte_t *vspace)
 {
     asid_pool_t *poolPtr;
 
     poolPtr = riscvKSASIDTable[ASID_HIGH(asid)];
-    if (poolPtr != NULL && poolPtr->array[ASID_LOW(asid)] == vspace) {
+    if (poolPtr != NULL && asid_pool_get_vspace_root(poolPtr, ASID_LOW(asid)) == vspace) {
+#ifdef ENABLE_SMP_SUPPORT
+        hwASIDFlushCores(asid, asid_pool_get_hart_mask(poolPtr, ASID_LOW(asid)));
+#else
         hwASIDFlush(asid);
-        poolPtr->array[ASID_LOW(asid)] = NULL;
+#endif
+        asid_pool_set_vspace_root(poolPtr, ASID_LOW(asid), NULL);
         setVMRoot(NODE_STATE(ksCurThread));
     }
 }
@@ -542,7 +598,7 @@ void unmapPageTable(asid_t asid, vptr_t vptr, pte_t *target_pt)
                   0,  /* read */
                   0  /* valid */
               );
-    sfence();
+    flushASID(asid);
 }
 
 static pte_t pte_pte_invalid_new(void)
@@ -563,16 +619,38 @@ void unmapPage(vm_page_size_t page_size, asid_t asid, vptr_t vptr, pptr_t pptr)
     }
 
     lu_ret = lookupPTSlot(find_ret.vspace_root, vptr);
-    if (unlikely(lu_ret.ptBitsLeft != pageBitsForSize(page_size))) {
+    if (unlikely(lu_ret.ptBitsLeft != pageLevelBitsForSize(page_size))) {
         return;
     }
-    if (!pte_ptr_get_valid(lu_ret.ptSlot) || isPTEPageTable(lu_ret.ptSlot)
-        || (pte_ptr_get_ppn(lu_ret.ptSlot) << seL4_PageBits) != pptr_to_paddr((void *)pptr)) {
+    if (!pte_ptr_get_valid(lu_ret.ptSlot) || isPTEPageTable(lu_ret.ptSlot)) {
         return;
     }
 
-    lu_ret.ptSlot[0] = pte_pte_invalid_new();
-    sfence();
+    word_t entries = 1;
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    /* a 64K frame must find its NAPOT mapping, any other frame must not */
+    if ((page_size == RISCV_64K_Page) != pte_ptr_is_napot(lu_ret.ptSlot)) {
+        return;
+    }
+    if (page_size == RISCV_64K_Page) {
+        entries = PTE_NAPOT_ENTRIES;
+    }
+    word_t ppn = pte_ptr_get_base_ppn(lu_ret.ptSlot);
+#else
+    word_t ppn = pte_ptr_get_ppn(lu_ret.ptSlot);
+#endif
+    if ((ppn << seL4_PageBits) != pptr_to_paddr((void *)pptr)) {
+        return;
+    }
+
+    for (word_t i = 0; i < entries; i++) {
+        lu_ret.ptSlot[i] = pte_pte_invalid_new();
+    }
+#ifdef CONFIG_RISCV_EXT_SVINVAL
+    flushPages(asid, vptr, entries, lu_ret.ptBitsLeft);
+#else
+    flushASID(asid);
+#endif
 }
 
 void setVMRoot(tcb_t *tcb)
@@ -598,6 +676,9 @@ void setVMRoot(tcb_t *tcb)
         return;
     }
 
+#ifdef ENABLE_SMP_SUPPORT
+    asid_pool_add_hart(riscvKSASIDTable[ASID_HIGH(asid)], ASID_LOW(asid), getCurrentCPUIndex());
+#endif
     setVSpaceRoot(addrFromPPtr(lvl1pt), asid);
 }
 
@@ -857,7 +938,7 @@ static exception_t decodeRISCVFrameInvocation(word_t label, word_t length,
 
         /* Check if this page is already mapped */
         lookupPTSlot_ret_t lu_ret = lookupPTSlot(lvl1pt, vaddr);
-        if (unlikely(lu_ret.ptBitsLeft != pageBitsForSize(frameSize))) {
+        if (unlikely(lu_ret.ptBitsLeft != pageLevelBitsForSize(frameSize))) {
             current_lookup_fault = lookup_fault_missing_capability_new(lu_ret.ptBitsLeft);
             current_syscall_error.type = seL4_FailedLookup;
             current_syscall_error.failedLookupWasSource = false;
@@ -894,6 +975,19 @@ static exception_t decodeRISCVFrameInvocation(word_t label, word_t length,
                 current_syscall_error.type = seL4_DeleteFirst;
                 return EXCEPTION_SYSCALL_ERROR;
             }
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+            /* a 64K mapping needs the whole naturally aligned group of PTEs */
+            if (frameSize == RISCV_64K_Page) {
+                for (word_t i = 1; i < PTE_NAPOT_ENTRIES; i++) {
+                    if (unlikely(pte_ptr_get_valid(lu_ret.ptSlot + i))) {
+                        userError("Virtual address (0x%"SEL4_PRIx_word") already mapped",
+                                  vaddr + (i << seL4_PageBits));
+                        current_syscall_error.type = seL4_DeleteFirst;
+                        return EXCEPTION_SYSCALL_ERROR;
+                    }
+                }
+            }
+#endif
         }
 
         vm_rights_t vmRights = maskVMRights(capVMRights, rightsFromWord(w_rightsMask));
@@ -903,6 +997,11 @@ static exception_t decodeRISCVFrameInvocation(word_t label, word_t length,
 
         bool_t executable = !vm_attributes_get_riscvExecuteNever(attr);
         pte_t pte = makeUserPTE(frame_paddr, executable, vmRights);
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+        if (frameSize == RISCV_64K_Page && pte_get_valid(pte)) {
+            pte = pte_make_napot(pte);
+        }
+#endif
         setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
         return performPageInvocationMapPTE(cap, cte, pte, lu_ret.ptSlot);
     }
@@ -1062,7 +1161,7 @@ exception_t decodeRISCVMMUInvocation(word_t label, word_t length, cptr_t cptr,
 
         /* Find first free ASID */
         asid = cap_asid_pool_cap_get_capASIDBase(cap);
-        for (i = 0; i < BIT(asidLowBits) && (asid + i == 0 || pool->array[i]); i++);
+        for (i = 0; i < BIT(asidLowBits) && (asid + i == 0 || asid_pool_get_vspace_root(pool, i)); i++);
 
         if (i == BIT(asidLowBits)) {
             current_syscall_error.type = seL4_DeleteFirst;
@@ -1085,7 +1184,7 @@ exception_t performPageTableInvocationMap(cap_t cap, cte_t *ctSlot,
 {
     ctSlot->cap = cap;
     *ptSlot = pte;
-    sfence();
+    flushASID(cap_page_table_cap_get_capPTMappedASID(cap));
 
     return EXCEPTION_NONE;
 }
@@ -1125,10 +1224,10 @@ static exception_t performPageGetAddress(void *vbase_ptr, bool_t call)
     return EXCEPTION_NONE;
 }
 
-static exception_t updatePTE(pte_t pte, pte_t *base)
+static exception_t updatePTE(asid_t asid, pte_t pte, pte_t *base)
 {
     *base = pte;
-    sfence();
+    flushASID(asid);
     return EXCEPTION_NONE;
 }
 
@@ -1136,7 +1235,14 @@ exception_t performPageInvocationMapPTE(cap_t cap, cte_t *ctSlot,
                                         pte_t pte, pte_t *base)
 {
     ctSlot->cap = cap;
-    return updatePTE(pte, base);
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    if (cap_frame_cap_get_capFSize(cap) == RISCV_64K_Page) {
+        for (word_t i = 1; i < PTE_NAPOT_ENTRIES; i++) {
+            base[i] = pte;
+        }
+    }
+#endif
+    return updatePTE(cap_frame_cap_get_capFMappedASID(cap), pte, base);
 }
 
 exception_t performPageInvocationUnmap(cap_t cap, cte_t *ctSlot)
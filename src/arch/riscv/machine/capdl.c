@@ -205,7 +205,11 @@ static void riscv_obj_pt_print_slots(pte_t *lvl1pt, pte_t *pt, int level)
                 printf("pt_%p_%04lu = pt\n", ptSlot, ptIndex);
                 riscv_obj_pt_print_slots(lvl1pt, getPPtrFromHWPTE(ptSlot), level - 1);
             } else { /* frame */
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+                paddr_t paddr = pte_ptr_get_base_ppn(ptSlot);
+#else
                 paddr_t paddr = pte_ptr_get_ppn(ptSlot);
+#endif
                 printf("frame_%p_%04lu = frame ", ptSlot, ptIndex);
                 obj_frame_print_attrs(paddr);
             }
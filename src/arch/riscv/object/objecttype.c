@@ -184,6 +184,10 @@ word_t Arch_getObjectSize(word_t t)
 #if CONFIG_PT_LEVELS > 3
     case seL4_RISCV_Tera_Page:
         return seL4_TeraPageBits;
+#endif
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    case seL4_RISCV_64K_Page:
+        return seL4_NapotPageBits;
 #endif
     default:
         fail("Invalid object type");
@@ -268,6 +272,18 @@ cap_t Arch_createObject(object_t t, void *regionBase, word_t userSize, bool_t
     }
 #endif
 
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    case seL4_RISCV_64K_Page:
+        return cap_frame_cap_new(
+                   asidInvalid,                    /* capFMappedASID       */
+                   (word_t) regionBase,            /* capFBasePtr          */
+                   RISCV_64K_Page,                 /* capFSize             */
+                   wordFromVMRights(VMReadWrite),  /* capFVMRights         */
+                   deviceMemory,                   /* capFIsDevice         */
+                   0                               /* capFMappedAddress    */
+               );
+#endif
+
     case seL4_RISCV_PageTableObject:
         /** AUXUPD: "(True, ptr_retyps 1
               (Ptr (ptr_val \<acute>regionBase) :: (pte_C[512]) ptr))" */
@@ -316,6 +332,9 @@ bool_t Arch_isFrameType(word_t type)
 #endif
 #if CONFIG_PT_LEVELS > 2
     case seL4_RISCV_Giga_Page:
+#endif
+#ifdef CONFIG_RISCV_EXT_SVNAPOT
+    case seL4_RISCV_64K_Page:
 #endif
     case seL4_RISCV_Mega_Page:
     case seL4_RISCV_4K_Page:
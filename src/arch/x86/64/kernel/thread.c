@@ -46,9 +46,14 @@ BOOT_CODE void Arch_configureIdleThread(tcb_t *tcb)
 
 void Arch_switchToIdleThread(void)
 {
-    tcb_t *tcb = NODE_STATE(ksIdleThread);
+    UNUSED tcb_t *tcb = NODE_STATE(ksIdleThread);
+#ifdef CONFIG_X86_LAZY_VSPACE_SWITCH
+    /* The idle thread only runs kernel code, which every vspace maps, so
+     * the vspace of the previous thread stays loaded */
+#else
     /* Force the idle thread to run on kernel page table */
     setVMRoot(tcb);
+#endif
 #ifdef ENABLE_SMP_SUPPORT
     asm volatile("movq %[value], %%gs:%c[offset]"
                  :
@@ -1049,21 +1049,89 @@ lookupPDSlot_ret_t lookupPDSlot(vspace_root_t *pml4, vptr_t vptr)
     }
 }
 
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+/* Returns whether anything was invalidated, as for flushTable. */
+static bool_t flushPD(vspace_root_t *vspace, word_t vptr, pde_t *pd, asid_t asid)
+#else
 static void flushPD(vspace_root_t *vspace, word_t vptr, pde_t *pd, asid_t asid)
+#endif
 {
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+    /* Large pages can be invalidated by address. A page table below this
+     * directory could hold up to 512 translations per entry, so if there
+     * is one, invalidate the whole PCID instead of walking it. */
+    word_t first = BIT(PD_INDEX_BITS);
+    word_t last = 0;
+
+    for (word_t i = 0; i < BIT(PD_INDEX_BITS); i++) {
+        if (pde_ptr_get_page_size(pd + i) == pde_pde_large) {
+            if (!pde_pde_large_ptr_get_present(pd + i)) {
+                continue;
+            }
+        } else if (!pde_pde_pt_ptr_get_present(pd + i)) {
+            continue;
+        } else {
+            invalidateASID(vspace, asid, SMP_TERNARY(tlb_bitmap_get(vspace), 0));
+            return true;
+        }
+        if (first == BIT(PD_INDEX_BITS)) {
+            first = i;
+        }
+        last = i;
+    }
+    if (first == BIT(PD_INDEX_BITS)) {
+        return false;
+    }
+    invalidatePCIDRange(vspace, vptr + (first << seL4_LargePageBits), vptr + ((last + 1) << seL4_LargePageBits),
+                        seL4_LargePageBits, asid, SMP_TERNARY(tlb_bitmap_get(vspace), 0));
+    return true;
+#else
     /* clearing the entire PCID vs flushing the virtual addresses
      * one by one using invplg.
      * choose the easy way, invalidate the PCID
      */
     invalidateASID(vspace, asid, SMP_TERNARY(tlb_bitmap_get(vspace), 0));
-
+#endif
 }
 
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+/* Returns whether anything was invalidated, as for flushTable. */
+static bool_t flushPDPT(vspace_root_t *vspace, word_t vptr, pdpte_t *pdpt, asid_t asid)
+#else
 static void flushPDPT(vspace_root_t *vspace, word_t vptr, pdpte_t *pdpt, asid_t asid)
+#endif
 {
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+    /* similar here, with huge pages in place of large pages */
+    word_t first = BIT(PDPT_INDEX_BITS);
+    word_t last = 0;
+
+    for (word_t i = 0; i < BIT(PDPT_INDEX_BITS); i++) {
+        if (pdpte_ptr_get_page_size(pdpt + i) == pdpte_pdpte_1g) {
+            if (!pdpte_pdpte_1g_ptr_get_present(pdpt + i)) {
+                continue;
+            }
+        } else if (!pdpte_pdpte_pd_ptr_get_present(pdpt + i)) {
+            continue;
+        } else {
+            invalidateASID(vspace, asid, SMP_TERNARY(tlb_bitmap_get(vspace), 0));
+            return true;
+        }
+        if (first == BIT(PDPT_INDEX_BITS)) {
+            first = i;
+        }
+        last = i;
+    }
+    if (first == BIT(PDPT_INDEX_BITS)) {
+        return false;
+    }
+    invalidatePCIDRange(vspace, vptr + (first << seL4_HugePageBits), vptr + ((last + 1) << seL4_HugePageBits),
+                        seL4_HugePageBits, asid, SMP_TERNARY(tlb_bitmap_get(vspace), 0));
+    return true;
+#else
     /* similar here */
     invalidateASID(vspace, asid, SMP_TERNARY(tlb_bitmap_get(vspace), 0));
-    return;
+#endif
 }
 
 void hwASIDInvalidate(asid_t asid, vspace_root_t *vspace)
@@ -1093,9 +1161,17 @@ void unmapPageDirectory(asid_t asid, vptr_t vaddr, pde_t *pd)
         return;
     }
 
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+    /* as in unmapPageTable */
+    *lu_ret.pdptSlot = makeUserPDPTEInvalid();
+    if (flushPD(find_ret.vspace_root, vaddr, pd, asid)) {
+        return;
+    }
+#else
     flushPD(find_ret.vspace_root, vaddr, pd, asid);
 
     *lu_ret.pdptSlot = makeUserPDPTEInvalid();
+#endif
 
     invalidatePageStructureCacheASID(pptr_to_paddr(find_ret.vspace_root), asid,
                                      SMP_TERNARY(tlb_bitmap_get(find_ret.vspace_root), 0));
@@ -1264,9 +1340,19 @@ static void unmapPDPT(asid_t asid, vptr_t vaddr, pdpte_t *pdpt)
         return;
     }
 
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+    /* as in unmapPageTable, except that an empty PDPT can still be cached
+     * through the PML4 entry, so its invalidation cannot be skipped */
+    *pml4Slot = makeUserPML4EInvalid();
+    if (!flushPDPT(find_ret.vspace_root, vaddr, pdpt, asid)) {
+        invalidatePageStructureCacheASID(pptr_to_paddr(find_ret.vspace_root), asid,
+                                         SMP_TERNARY(tlb_bitmap_get(find_ret.vspace_root), 0));
+    }
+#else
     flushPDPT(find_ret.vspace_root, vaddr, pdpt, asid);
 
     *pml4Slot = makeUserPML4EInvalid();
+#endif
 }
 
 static exception_t performX64PDPTInvocationUnmap(cap_t cap, cte_t *ctSlot)
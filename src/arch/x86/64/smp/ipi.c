@@ -21,6 +21,12 @@ void Mode_handleRemoteCall(IpiModeRemoteCall_t call, word_t arg0, word_t arg1, w
         invalidateLocalASID((vspace_root_t *)arg0, arg1);
         break;
 
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+    case IpiRemoteCall_InvalidatePCIDRange:
+        invalidateLocalPCIDRange(arg0 & ~MASK(seL4_PageBits), arg1, arg0 & MASK(seL4_PageBits), arg2);
+        break;
+#endif
+
     default:
         fail("Invalid remote call");
     }
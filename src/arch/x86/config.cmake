@@ -139,6 +139,29 @@ config_option(
     DEFAULT_DISABLED OFF
 )
 
+config_string(
+    KernelX86TLBFlushPageThreshold X86_TLB_FLUSH_PAGE_THRESHOLD
+    "When a page table, page directory or PDPT is unmapped, the translations of the \
+    pages it maps are invalidated one address at a time, on this core and on every \
+    core that has used the address space, if they span at most this many pages. \
+    Larger ranges invalidate the whole PCID instead. Either way the paging-structure \
+    caches of the PCID are dropped with the translations. Zero keeps the previous \
+    behaviour."
+    DEFAULT 32
+    DEPENDS "KernelSel4ArchX86_64;NOT KernelVerificationBuild" DEFAULT_DISABLED 0
+    UNQUOTE
+)
+
+config_option(
+    KernelX86LazyVSpaceSwitch X86_LAZY_VSPACE_SWITCH
+    "Leave the previous address space loaded in CR3 when a core switches to its idle \
+    thread, which only runs kernel code. Switching back to the same address space \
+    then needs no CR3 write at all. A core holding an address space this way drops \
+    it when it receives a shootdown for that address space."
+    DEFAULT OFF
+    DEPENDS "KernelSel4ArchX86_64;NOT KernelVerificationBuild"
+)
+
 config_choice(
     KernelSyscall
     KERNEL_X86_SYSCALL
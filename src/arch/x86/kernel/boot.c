@@ -385,6 +385,9 @@ BOOT_CODE bool_t init_cpu(
             write_cr4(read_cr4() | CR4_SMAP);
         }
     }
+#ifdef CONFIG_KERNEL_ARCH_CLEAR_MEMORY
+    x86KSclearMemoryRepStos = cpuid_007h_ebx_get_enhanced_rep_mov(ebx_007);
+#endif
     if (cpuid_007h_ebx_get_smep(ebx_007)) {
         /* similar to smap we cannot enable smep if using dangerous code injection. it
          * does not affect stack trace printing though */
@@ -690,9 +690,38 @@ vm_rights_t CONST maskVMRights(vm_rights_t vm_rights, seL4_CapRights_t cap_right
     return VMKernelOnly;
 }
 
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+/* Returns whether anything was invalidated. Every invalidation used here also
+ * drops the paging-structure caches of the PCID, so the caller only needs to
+ * invalidate those itself if nothing was. */
+bool_t flushTable(vspace_root_t *vspace, word_t vptr, pte_t *pt, asid_t asid)
+#else
 void flushTable(vspace_root_t *vspace, word_t vptr, pte_t *pt, asid_t asid)
+#endif
 {
     word_t i;
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+    word_t first = BIT(PT_INDEX_BITS);
+    word_t last = 0;
+
+    assert(IS_ALIGNED(vptr, PT_INDEX_BITS + PAGE_BITS));
+
+    /* find the span of valid mappings and invalidate it in one go */
+    for (i = 0; i < BIT(PT_INDEX_BITS); i++) {
+        if (pte_get_present(pt[i])) {
+            if (first == BIT(PT_INDEX_BITS)) {
+                first = i;
+            }
+            last = i;
+        }
+    }
+    if (first == BIT(PT_INDEX_BITS)) {
+        return false;
+    }
+    invalidatePCIDRange(vspace, vptr + (first << PAGE_BITS), vptr + ((last + 1) << PAGE_BITS), PAGE_BITS,
+                        asid, SMP_TERNARY(tlb_bitmap_get(vspace), 0));
+    return true;
+#else
     cap_t        threadRoot;
 
     assert(IS_ALIGNED(vptr, PT_INDEX_BITS + PAGE_BITS));
@@ -709,6 +738,7 @@ void flushTable(vspace_root_t *vspace, word_t vptr, pte_t *pt, asid_t asid)
             }
         }
     }
+#endif
 }
 
 
@@ -760,10 +790,33 @@ void unmapPage(vm_page_size_t page_size, asid_t asid, vptr_t vptr, void *pptr)
         break;
     }
 
+#if defined(CONFIG_KERNEL_REVOKE_BATCH) && defined(ENABLE_SMP_SUPPORT)
+    if (x86KSrevokeBatchActive) {
+        invalidateLocalTranslationSingleASID(vptr, asid);
+        x86KSrevokeBatchMask |= tlb_bitmap_get(find_ret.vspace_root);
+        return;
+    }
+#endif
     invalidateTranslationSingleASID(vptr, asid,
                                     SMP_TERNARY(tlb_bitmap_get(find_ret.vspace_root), 0));
 }
 
+#if defined(CONFIG_KERNEL_REVOKE_BATCH) && defined(ENABLE_SMP_SUPPORT)
+void Arch_beginRevokeBatch(void)
+{
+    x86KSrevokeBatchActive = true;
+    x86KSrevokeBatchMask = 0;
+}
+
+void Arch_endRevokeBatch(void)
+{
+    x86KSrevokeBatchActive = false;
+    if (x86KSrevokeBatchMask) {
+        doRemoteInvalidateTranslationAll(x86KSrevokeBatchMask);
+    }
+}
+#endif
+
 void unmapPageTable(asid_t asid, vptr_t vaddr, pte_t *pt)
 {
     findVSpaceForASID_ret_t find_ret;
@@ -786,9 +839,18 @@ void unmapPageTable(asid_t asid, vptr_t vaddr, pte_t *pt)
         return;
     }
 
+#if CONFIG_X86_TLB_FLUSH_PAGE_THRESHOLD > 0
+    /* Clear the entry first, so that the flush also catches any walk that
+     * cached it in the meantime. */
+    *lu_ret.pdSlot = makeUserPDEInvalid();
+    if (flushTable(find_ret.vspace_root, vaddr, pt, asid)) {
+        return;
+    }
+#else
     flushTable(find_ret.vspace_root, vaddr, pt, asid);
 
     *lu_ret.pdSlot = makeUserPDEInvalid();
+#endif
 
     invalidatePageStructureCacheASID(pptr_to_paddr(find_ret.vspace_root), asid,
                                      SMP_TERNARY(tlb_bitmap_get(find_ret.vspace_root), 0));
@@ -929,6 +991,97 @@ static create_mapping_pde_return_t createSafeMappingEntries_PDE(paddr_t base, wo
 }
 
 
+#ifdef CONFIG_KERNEL_IPC_PAGE_GRANT
+/* Remap the frame in slot from wherever it is mapped to vaddr in the
+ * receiver's VSpace, provided it fits in the size bytes of grant window left
+ * there. Returns the size of the frame, or 0 without changing any state if the
+ * frame cannot be granted, in which case the caller falls back to an ordinary
+ * capability transfer. */
+word_t Arch_grantFrame(cte_t *slot, tcb_t *receiver, vptr_t vaddr, word_t size)
+{
+    cap_t cap = slot->cap;
+    cap_t vspaceCap;
+    vspace_root_t *vspace;
+    vm_page_size_t frameSize;
+    vm_rights_t vmRights;
+    vm_attributes_t vmAttr;
+    findVSpaceForASID_ret_t find_ret;
+    asid_t asid;
+    paddr_t paddr;
+
+    if (cap_get_capType(cap) != cap_frame_cap) {
+        return 0;
+    }
+
+    if (cap_frame_cap_get_capFMappedASID(cap) != asidInvalid &&
+        cap_frame_cap_get_capFMapType(cap) != X86_MappingVSpace) {
+        return 0;
+    }
+
+    frameSize = cap_frame_cap_get_capFSize(cap);
+    if (BIT(pageBitsForSize(frameSize)) > size ||
+        !checkVPAlignment(frameSize, vaddr)) {
+        return 0;
+    }
+
+    vspaceCap = TCB_PTR_CTE_PTR(receiver, tcbVTable)->cap;
+    if (!isValidNativeRoot(vspaceCap)) {
+        return 0;
+    }
+    vspace = (vspace_root_t *)pptr_of_cap(vspaceCap);
+    asid = cap_get_capMappedASID(vspaceCap);
+
+    find_ret = findVSpaceForASID(asid);
+    if (find_ret.status != EXCEPTION_NONE || find_ret.vspace_root != vspace) {
+        return 0;
+    }
+
+    paddr = pptr_to_paddr((void *)cap_frame_cap_get_capFBasePtr(cap));
+    vmRights = cap_frame_cap_get_capFVMRights(cap);
+    vmAttr = vmAttributesFromWord(0);
+
+    switch (frameSize) {
+    case X86_SmallPage: {
+        create_mapping_pte_return_t map_ret;
+
+        map_ret = createSafeMappingEntries_PTE(paddr, vaddr, vmRights, vmAttr, vspace);
+        if (map_ret.status != EXCEPTION_NONE || pte_ptr_get_present(map_ret.ptSlot)) {
+            return 0;
+        }
+
+        performX86FrameInvocationUnmap(cap, slot);
+        cap = cap_frame_cap_set_capFMappedASID(slot->cap, asid);
+        cap = cap_frame_cap_set_capFMappedAddress(cap, vaddr);
+        cap = cap_frame_cap_set_capFMapType(cap, X86_MappingVSpace);
+        performX86PageInvocationMapPTE(cap, slot, map_ret.ptSlot, map_ret.pte, vspace);
+        return BIT(pageBitsForSize(frameSize));
+    }
+
+    case X86_LargePage: {
+        create_mapping_pde_return_t map_ret;
+
+        map_ret = createSafeMappingEntries_PDE(paddr, vaddr, vmRights, vmAttr, vspace);
+        if (map_ret.status != EXCEPTION_NONE ||
+            (pde_ptr_get_page_size(map_ret.pdSlot) == pde_pde_large &&
+             pde_pde_large_ptr_get_present(map_ret.pdSlot))) {
+            return 0;
+        }
+
+        performX86FrameInvocationUnmap(cap, slot);
+        cap = cap_frame_cap_set_capFMappedASID(slot->cap, asid);
+        cap = cap_frame_cap_set_capFMappedAddress(cap, vaddr);
+        cap = cap_frame_cap_set_capFMapType(cap, X86_MappingVSpace);
+        performX86PageInvocationMapPDE(cap, slot, map_ret.pdSlot, map_ret.pde, vspace);
+        return BIT(pageBitsForSize(frameSize));
+    }
+
+    default:
+        /* huge pages are not granted */
+        return 0;
+    }
+}
+#endif /* CONFIG_KERNEL_IPC_PAGE_GRANT */
+
 exception_t decodeX86FrameInvocation(
     word_t invLabel,
     word_t length,
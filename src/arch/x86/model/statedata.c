@@ -38,6 +38,17 @@ SMP_STATE_DEFINE(cpu_id_mapping_t, cpu_mapping);
 
 /* CPU Cache Line Size */
 uint32_t x86KScacheLineSizeBits;
+#ifdef CONFIG_KERNEL_ARCH_CLEAR_MEMORY
+/* Whether rep stosb is fast enough to clear memory with (ERMS) */
+bool_t x86KSclearMemoryRepStos;
+#endif
+
+#if defined(CONFIG_KERNEL_REVOKE_BATCH) && defined(ENABLE_SMP_SUPPORT)
+/* Whether a batched revoke is deferring remote TLB shootdowns, and the cores
+ * that still need one */
+bool_t x86KSrevokeBatchActive;
+word_t x86KSrevokeBatchMask;
+#endif
 
 /* A valid initial FPU state, copied to every new thread. */
 user_fpu_state_t x86KSnullFpuState ALIGN(MIN_FPU_ALIGNMENT);
@@ -48,3 +48,8 @@ add_sources(
         src/object/schedcontrol.c
         src/kernel/sporadic.c
 )
+add_sources(
+    DEP KernelRing
+    CFILES
+        src/object/ring.c
+)
@@ -38,6 +38,9 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
     /* Check there's no extra caps, the length is ok and there's no
      * saved fault. */
     if (unlikely(fastpath_mi_check(msgInfo) ||
+#ifdef CONFIG_KERNEL_BULK_CAP_TRANSFER
+                 (seL4_MessageInfo_get_label(info) & seL4_MsgBulkCapsLabel) ||
+#endif
                  fault_type != seL4_Fault_NullFault)) {
         slowpath(SysCall);
     }
@@ -105,7 +108,7 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
     }
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
     /* Ensure the vmid is valid. */
-    if (unlikely(!asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map))) {
+    if (unlikely(!isVMIDCurrent_fp(asid_map))) {
         slowpath(SysCall);
     }
     /* vmids are the tags used instead of hw_asids in hyp mode */
@@ -175,9 +178,9 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
 #endif
 
     /* Dequeue the destination. */
-    endpoint_ptr_set_epQueue_head_np(ep_ptr, TCB_REF(dest->tcbEPNext));
-    if (unlikely(dest->tcbEPNext)) {
-        dest->tcbEPNext->tcbEPPrev = NULL;
+    endpoint_ptr_set_epQueue_head_np(ep_ptr, TCB_REF(tcb_ptr_get_tcbEPNext(dest)));
+    if (unlikely(tcb_ptr_get_tcbEPNext(dest))) {
+        tcb_ptr_set_tcbEPPrev(tcb_ptr_get_tcbEPNext(dest), NULL);
     } else {
         endpoint_ptr_mset_epQueue_tail_state(ep_ptr, 0, EPState_Idle);
     }
@@ -264,6 +267,9 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     /* Check there's no extra caps, the length is ok and there's no
      * saved fault. */
     if (unlikely(fastpath_mi_check(msgInfo) ||
+#ifdef CONFIG_KERNEL_BULK_CAP_TRANSFER
+                 (seL4_MessageInfo_get_label(info) & seL4_MsgBulkCapsLabel) ||
+#endif
                  fault_type != seL4_Fault_NullFault)) {
         slowpath(SysReplyRecv);
     }
@@ -382,7 +388,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     }
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
     /* Ensure the vmid is valid. */
-    if (unlikely(!asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map))) {
+    if (unlikely(!isVMIDCurrent_fp(asid_map))) {
         slowpath(SysReplyRecv);
     }
 
@@ -455,8 +461,8 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     /* Place the thread in the endpoint queue */
     endpointTail = endpoint_ptr_get_epQueue_tail_fp(ep_ptr);
     if (likely(!endpointTail)) {
-        NODE_STATE(ksCurThread)->tcbEPPrev = NULL;
-        NODE_STATE(ksCurThread)->tcbEPNext = NULL;
+        tcb_ptr_set_tcbEPPrev(NODE_STATE(ksCurThread), NULL);
+        tcb_ptr_set_tcbEPNext(NODE_STATE(ksCurThread), NULL);
 
         /* Set head/tail of queue and endpoint state. */
         endpoint_ptr_set_epQueue_head_np(ep_ptr, TCB_REF(NODE_STATE(ksCurThread)));
@@ -470,9 +476,9 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
         endpoint_ptr_mset_epQueue_tail_state(ep_ptr, TCB_REF(queue.end), EPState_Recv);
 #else
         /* Append current thread onto the queue. */
-        endpointTail->tcbEPNext = NODE_STATE(ksCurThread);
-        NODE_STATE(ksCurThread)->tcbEPPrev = endpointTail;
-        NODE_STATE(ksCurThread)->tcbEPNext = NULL;
+        tcb_ptr_set_tcbEPNext(endpointTail, NODE_STATE(ksCurThread));
+        tcb_ptr_set_tcbEPPrev(NODE_STATE(ksCurThread), endpointTail);
+        tcb_ptr_set_tcbEPNext(NODE_STATE(ksCurThread), NULL);
 
         /* Update tail of queue. */
         endpoint_ptr_mset_epQueue_tail_state(ep_ptr, TCB_REF(NODE_STATE(ksCurThread)),
@@ -782,7 +788,7 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
     }
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
     /* Ensure the vmid is valid. */
-    if (unlikely(!asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map))) {
+    if (unlikely(!isVMIDCurrent_fp(asid_map))) {
         vm_fault_slowpath(type);
     }
 
@@ -841,9 +847,9 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
 #endif
 
     /* Dequeue the destination. */
-    endpoint_ptr_set_epQueue_head_np(ep_ptr, TCB_REF(dest->tcbEPNext));
-    if (unlikely(dest->tcbEPNext)) {
-        dest->tcbEPNext->tcbEPPrev = NULL;
+    endpoint_ptr_set_epQueue_head_np(ep_ptr, TCB_REF(tcb_ptr_get_tcbEPNext(dest)));
+    if (unlikely(tcb_ptr_get_tcbEPNext(dest))) {
+        tcb_ptr_set_tcbEPPrev(tcb_ptr_get_tcbEPNext(dest), NULL);
     } else {
         endpoint_ptr_mset_epQueue_tail_state(ep_ptr, 0, EPState_Idle);
     }
@@ -390,6 +390,47 @@ BOOT_CODE bool_t provide_cap(cap_t root_cnode_cap, cap_t cap)
     return true;
 }
 
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+/* Record that the whole large pages of a region of the initial thread's
+ * address space are mapped with large frames. This requires the physical and
+ * virtual addresses of the region to be congruent modulo the large page size.
+ * The regions must be added before the rootserver objects are allocated, as
+ * they need fewer paging structures. */
+BOOT_CODE void add_it_large_region(v_region_t v_reg, sword_t pv_offset)
+{
+    v_region_t large = {
+        .start = ROUND_UP(v_reg.start, seL4_LargePageBits),
+        .end   = ROUND_DOWN(v_reg.end, seL4_LargePageBits)
+    };
+
+    if (!IS_ALIGNED((word_t)pv_offset, seL4_LargePageBits) || large.start >= large.end) {
+        return;
+    }
+    assert(ndks_boot.it_large_count < MAX_NUM_IT_LARGE_REG);
+    ndks_boot.it_large_reg[ndks_boot.it_large_count] = large;
+    ndks_boot.it_large_count++;
+}
+
+BOOT_CODE bool_t is_it_large_frame(vptr_t vptr)
+{
+    for (word_t i = 0; i < ndks_boot.it_large_count; i++) {
+        if (vptr >= ndks_boot.it_large_reg[i].start && vptr < ndks_boot.it_large_reg[i].end) {
+            return true;
+        }
+    }
+    return false;
+}
+
+BOOT_CODE word_t get_n_it_large_frames(void)
+{
+    word_t n = 0;
+    for (word_t i = 0; i < ndks_boot.it_large_count; i++) {
+        n += (ndks_boot.it_large_reg[i].end - ndks_boot.it_large_reg[i].start) >> seL4_LargePageBits;
+    }
+    return n;
+}
+#endif
+
 BOOT_CODE create_frames_of_region_ret_t create_frames_of_region(
     cap_t    root_cnode_cap,
     cap_t    pd_cap,
@@ -399,15 +440,33 @@ BOOT_CODE create_frames_of_region_ret_t create_frames_of_region(
 )
 {
     pptr_t     f;
+    word_t     f_bits;
+    vptr_t     vptr;
     cap_t      frame_cap;
     seL4_SlotPos slot_pos_before;
     seL4_SlotPos slot_pos_after;
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+    seL4_SlotRegion large = S_REG_EMPTY;
+#endif
 
     slot_pos_before = ndks_boot.slot_pos_cur;
 
-    for (f = reg.start; f < reg.end; f += BIT(PAGE_BITS)) {
+    for (f = reg.start; f < reg.end; f += BIT(f_bits)) {
+        f_bits = PAGE_BITS;
         if (do_map) {
-            frame_cap = create_mapped_it_frame_cap(pd_cap, f, pptr_to_paddr((void *)(f - pv_offset)), IT_ASID, false, true);
+            vptr = pptr_to_paddr((void *)(f - pv_offset));
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+            if (is_it_large_frame(vptr)) {
+                assert(IS_ALIGNED(f, seL4_LargePageBits) && f + BIT(seL4_LargePageBits) <= reg.end);
+                f_bits = seL4_LargePageBits;
+                /* the large frames of a region are contiguous */
+                if (large.start == large.end) {
+                    large.start = ndks_boot.slot_pos_cur;
+                }
+                large.end = ndks_boot.slot_pos_cur + 1;
+            }
+#endif
+            frame_cap = create_mapped_it_frame_cap(pd_cap, f, vptr, IT_ASID, f_bits != PAGE_BITS, true);
         } else {
             frame_cap = create_unmapped_it_frame_cap(f, false);
         }
@@ -426,6 +485,9 @@ BOOT_CODE create_frames_of_region_ret_t create_frames_of_region(
             .start = slot_pos_before,
             .end   = slot_pos_after
         },
+#ifdef CONFIG_ROOTSERVER_LARGE_PAGES
+        .large = large,
+#endif
         .success = true
     };
 }
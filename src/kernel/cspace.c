@@ -9,6 +9,7 @@
 #include <api/failures.h>
 #include <kernel/thread.h>
 #include <kernel/cspace.h>
+#include <kernel/lookupcache.h>
 #include <model/statedata.h>
 #include <arch/machine.h>
 
@@ -55,8 +56,26 @@ lookupSlot_raw_ret_t lookupSlot(tcb_t *thread, cptr_t capptr)
     lookupSlot_raw_ret_t ret;
 
     threadRoot = TCB_PTR_CTE_PTR(thread, tcbCTable)->cap;
+
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+    if (likely(cap_get_capType(threadRoot) == cap_cnode_cap)) {
+        cte_t *slot = lookupCacheGet(threadRoot, capptr);
+        if (likely(slot != NULL)) {
+            ret.status = EXCEPTION_NONE;
+            ret.slot = slot;
+            return ret;
+        }
+    }
+#endif
+
     res_ret = resolveAddressBits(threadRoot, capptr, wordBits);
 
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+    if (res_ret.status == EXCEPTION_NONE) {
+        lookupCachePut(threadRoot, capptr, res_ret.slot);
+    }
+#endif
+
     ret.status = res_ret.status;
     ret.slot = res_ret.slot;
     return ret;
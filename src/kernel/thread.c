@@ -24,9 +24,15 @@
 
 static seL4_MessageInfo_t
 transferCaps(seL4_MessageInfo_t info,
-             endpoint_t *endpoint, tcb_t *receiver,
+             endpoint_t *endpoint, tcb_t *sender, tcb_t *receiver,
              word_t *receiveBuffer);
 
+#ifdef CONFIG_KERNEL_BULK_CAP_TRANSFER
+static word_t transferBulkCaps(tcb_t *sender, word_t *sendBuffer,
+                               tcb_t *receiver, word_t *receiveBuffer,
+                               word_t count);
+#endif
+
 BOOT_CODE void configureIdleThread(tcb_t *tcb)
 {
     tcb->tcbFlags = seL4_TCBFlag_fpuDisabled;
@@ -208,6 +214,30 @@ void doNormalTransfer(tcb_t *sender, word_t *sendBuffer, endpoint_t *endpoint,
 
     tag = messageInfoFromWord(getRegister(sender, msgInfoRegister));
 
+#ifdef CONFIG_KERNEL_BULK_CAP_TRANSFER
+    if (seL4_MessageInfo_get_label(tag) & seL4_MsgBulkCapsLabel) {
+        /* The message registers name the caps to transfer. The receiver is
+         * told how many were transferred through the message length, and
+         * gets nothing of the sender's CSpace if grant is refused. */
+        msgTransferred = 0;
+        if (canGrant) {
+            msgTransferred = seL4_MessageInfo_get_length(tag);
+            if (!sendBuffer) {
+                msgTransferred = MIN(msgTransferred, n_msgRegisters);
+            }
+            msgTransferred = transferBulkCaps(sender, sendBuffer, receiver,
+                                              receiveBuffer, msgTransferred);
+            copyMRs(sender, sendBuffer, receiver, receiveBuffer, msgTransferred);
+        }
+
+        tag = seL4_MessageInfo_new(seL4_MessageInfo_get_label(tag) & ~seL4_MsgBulkCapsLabel,
+                                   0, 0, msgTransferred);
+        setRegister(receiver, msgInfoRegister, wordFromMessageInfo(tag));
+        setRegister(receiver, badgeRegister, badge);
+        return;
+    }
+#endif
+
     if (canGrant) {
         status = lookupExtraCaps(sender, sendBuffer, tag);
         if (unlikely(status != EXCEPTION_NONE)) {
@@ -220,7 +250,7 @@ void doNormalTransfer(tcb_t *sender, word_t *sendBuffer, endpoint_t *endpoint,
     msgTransferred = copyMRs(sender, sendBuffer, receiver, receiveBuffer,
                              seL4_MessageInfo_get_length(tag));
 
-    tag = transferCaps(tag, endpoint, receiver, receiveBuffer);
+    tag = transferCaps(tag, endpoint, sender, receiver, receiveBuffer);
 
     tag = seL4_MessageInfo_set_length(tag, msgTransferred);
     setRegister(receiver, msgInfoRegister, wordFromMessageInfo(tag));
@@ -242,7 +272,7 @@ void doFaultTransfer(word_t badge, tcb_t *sender, tcb_t *receiver,
 
 /* Like getReceiveSlots, this is specialised for single-cap transfer. */
 static seL4_MessageInfo_t transferCaps(seL4_MessageInfo_t info,
-                                       endpoint_t *endpoint, tcb_t *receiver,
+                                       endpoint_t *endpoint, tcb_t *sender, tcb_t *receiver,
                                        word_t *receiveBuffer)
 {
     word_t i;
@@ -278,6 +308,19 @@ static seL4_MessageInfo_t transferCaps(seL4_MessageInfo_t info,
                 break;
             }
 
+#ifdef CONFIG_KERNEL_IPC_PAGE_GRANT
+            /* Move a frame into the receiver's grant window rather than
+             * copying it, if both sides have asked for that. */
+            if ((sender->tcbFlags & seL4_TCBFlag_grantFrames) &&
+                receiver->tcbGrantWindowSize != 0 &&
+                Arch_grantFrame(slot, receiver, receiver->tcbGrantWindowBase,
+                                receiver->tcbGrantWindowSize)) {
+                cteMove(slot->cap, slot, destSlot);
+                destSlot = NULL;
+                continue;
+            }
+#endif
+
             dc_ret = deriveCap(slot, cap);
 
             if (dc_ret.status != EXCEPTION_NONE) {
@@ -296,6 +339,86 @@ static seL4_MessageInfo_t transferCaps(seL4_MessageInfo_t info,
     return seL4_MessageInfo_set_extraCaps(info, i);
 }
 
+#ifdef CONFIG_KERNEL_BULK_CAP_TRANSFER
+/* Transfer the caps named by the first count message registers of the sender
+ * into consecutive slots of the receiver's receive window, stopping at the
+ * first cap that cannot be transferred. The count is bounded by the message
+ * length, so like copyMRs this does a bounded amount of work. */
+static word_t transferBulkCaps(tcb_t *sender, word_t *sendBuffer,
+                               tcb_t *receiver, word_t *receiveBuffer,
+                               word_t count)
+{
+    cap_transfer_t ct;
+    lookupCap_ret_t luc_ret;
+    word_t i;
+#ifdef CONFIG_KERNEL_IPC_PAGE_GRANT
+    bool_t grant = (sender->tcbFlags & seL4_TCBFlag_grantFrames) &&
+                   receiver->tcbGrantWindowSize != 0;
+    vptr_t grantBase = receiver->tcbGrantWindowBase;
+    word_t grantSize = receiver->tcbGrantWindowSize;
+#endif
+
+    if (!receiveBuffer) {
+        return 0;
+    }
+
+    ct = loadCapTransfer(receiveBuffer);
+    count = MIN(count, MAX(ct.ctReceiveCount, 1));
+
+    luc_ret = lookupCap(receiver, ct.ctReceiveRoot);
+    if (luc_ret.status != EXCEPTION_NONE) {
+        return 0;
+    }
+
+    for (i = 0; i < count; i++) {
+        lookupSlot_raw_ret_t src_ret;
+        lookupSlot_ret_t dest_ret;
+        deriveCap_ret_t dc_ret;
+        cptr_t cptr;
+
+        if (i < n_msgRegisters) {
+            cptr = getRegister(sender, msgRegisters[i]);
+        } else {
+            cptr = sendBuffer[i + 1];
+        }
+
+        src_ret = lookupSlot(sender, cptr);
+        if (src_ret.status != EXCEPTION_NONE ||
+            cap_get_capType(src_ret.slot->cap) == cap_null_cap) {
+            break;
+        }
+
+        dest_ret = lookupTargetSlot(luc_ret.cap, ct.ctReceiveIndex + i, ct.ctReceiveDepth);
+        if (dest_ret.status != EXCEPTION_NONE ||
+            cap_get_capType(dest_ret.slot->cap) != cap_null_cap) {
+            break;
+        }
+
+#ifdef CONFIG_KERNEL_IPC_PAGE_GRANT
+        if (grant) {
+            word_t granted = Arch_grantFrame(src_ret.slot, receiver, grantBase, grantSize);
+            if (granted) {
+                cteMove(src_ret.slot->cap, src_ret.slot, dest_ret.slot);
+                grantBase += granted;
+                grantSize -= granted;
+                continue;
+            }
+        }
+#endif
+
+        dc_ret = deriveCap(src_ret.slot, src_ret.slot->cap);
+        if (dc_ret.status != EXCEPTION_NONE ||
+            cap_get_capType(dc_ret.cap) == cap_null_cap) {
+            break;
+        }
+
+        cteInsert(dc_ret.cap, src_ret.slot, dest_ret.slot);
+    }
+
+    return i;
+}
+#endif /* CONFIG_KERNEL_BULK_CAP_TRANSFER */
+
 void doNBRecvFailedTransfer(tcb_t *thread)
 {
     /* Set the badge register to 0 to indicate there was no message */
@@ -728,7 +851,7 @@ static inline bool_t PURE release_q_non_empty_and_ready(void)
 static void tcbReleaseDequeue(void)
 {
     assert(NODE_STATE(ksReleaseQueue.head) != NULL);
-    assert(NODE_STATE(ksReleaseQueue.head)->tcbSchedPrev == NULL);
+    assert(tcb_ptr_get_tcbSchedPrev(NODE_STATE(ksReleaseQueue.head)) == NULL);
     SMP_COND_STATEMENT(assert(NODE_STATE(ksReleaseQueue.head)->tcbAffinity == getCurrentCPUIndex()));
 
     tcb_t *awakened = NODE_STATE(ksReleaseQueue.head);
@@ -221,6 +221,17 @@ void cap_ntfn_print_attrs(cap_t ntfn)
     badge ? printf(", badge: %lu)\n", badge) : printf(")\n");
 }
 
+#ifdef CONFIG_KERNEL_RING
+void cap_ring_print_attrs(cap_t ring)
+{
+    printf("(");
+    cap_ring_cap_get_capRingCanReceive(ring) ? putchar('R') : 0;
+    cap_ring_cap_get_capRingCanSend(ring) ? putchar('W') : 0;
+    long unsigned int badge = cap_ring_cap_get_capRingBadge(ring);
+    badge ? printf(", badge: %lu)\n", badge) : printf(")\n");
+}
+#endif
+
 /*
  * print object slots
  */
@@ -418,6 +429,14 @@ void print_cap(cap_t cap)
         cap_ntfn_print_attrs(cap);
         break;
     }
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap: {
+        printf("%p_ring ",
+               (void *)cap_ring_cap_get_capRingPtr(cap));
+        cap_ring_print_attrs(cap);
+        break;
+    }
+#endif
     case cap_untyped_cap: {
         printf("%p_untyped\n",
                (void *)cap_untyped_cap_get_capPtr(cap));
@@ -481,6 +500,13 @@ void print_object(cap_t cap)
                (void *)cap_notification_cap_get_capNtfnPtr(cap));
         break;
     }
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap: {
+        printf("%p_ring = ring\n",
+               (void *)cap_ring_cap_get_capRingPtr(cap));
+        break;
+    }
+#endif
     case cap_thread_cap: {
         /* this object has already got handle by `print_objects` */
         break;
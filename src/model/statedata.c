@@ -61,6 +61,9 @@ UP_STATE_DEFINE(sched_context_t *, ksIdleSC);
 #ifdef CONFIG_DEBUG_BUILD
 UP_STATE_DEFINE(tcb_t *, ksDebugTCBs);
 #endif /* CONFIG_DEBUG_BUILD */
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+UP_STATE_DEFINE(lookup_cache_entry_t, ksLookupCache[BIT(LOOKUP_CACHE_BITS)]);
+#endif
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
 UP_STATE_DEFINE(bool_t, benchmark_log_utilisation_enabled);
 UP_STATE_DEFINE(timestamp_t, benchmark_start_time);
@@ -74,6 +77,12 @@ UP_STATE_DEFINE(timestamp_t, benchmark_kernel_number_schedules);
  * pending interrupts */
 word_t ksWorkUnitsCompleted;
 
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+/* Generation of valid lookup cache entries. It starts at 1 so that the
+ * zero-initialised caches hold no valid entries. */
+word_t ksLookupCacheGeneration = 1;
+#endif
+
 irq_state_t intStateIRQTable[INT_STATE_ARRAY_SIZE];
 /* CNode containing interrupt handler endpoints - like all seL4 objects, this CNode needs to be
  * of a size that is a power of 2 and aligned to its size. */
@@ -18,6 +18,7 @@
 #include <object/untyped.h>
 #include <kernel/cspace.h>
 #include <kernel/thread.h>
+#include <kernel/lookupcache.h>
 #include <model/preemption.h>
 #include <model/statedata.h>
 #include <util.h>
@@ -31,16 +32,26 @@ typedef struct finaliseSlot_ret finaliseSlot_ret_t;
 
 static finaliseSlot_ret_t finaliseSlot(cte_t *slot, bool_t exposed);
 static void emptySlot(cte_t *slot, cap_t cleanupInfo);
+#ifdef CONFIG_KERNEL_REVOKE_BATCH
+static inline bool_t CONST capRemovable(cap_t cap, cte_t *slot);
+#endif
 static exception_t reduceZombie(cte_t *slot, bool_t exposed);
+#ifdef CONFIG_KERNEL_MDB_STATS
+static bool_t mdbStatsWalkBusy(tcb_t *thread);
+#endif
 
-#ifdef CONFIG_KERNEL_MCS
+#if defined(CONFIG_KERNEL_CNODE_BATCH)
+#define CNODE_LAST_INVOCATION CNodeBatch
+#elif defined(CONFIG_KERNEL_MDB_STATS)
+#define CNODE_LAST_INVOCATION CNodeMDBStats
+#elif defined(CONFIG_KERNEL_MCS)
 #define CNODE_LAST_INVOCATION CNodeRotate
 #else
 #define CNODE_LAST_INVOCATION CNodeSaveCaller
 #endif
 
 exception_t decodeCNodeInvocation(word_t invLabel, word_t length, cap_t cap,
-                                  word_t *buffer)
+                                  bool_t call, word_t *buffer)
 {
     lookupSlot_ret_t lu_ret;
     cte_t *destSlot;
@@ -56,6 +67,45 @@ exception_t decodeCNodeInvocation(word_t invLabel, word_t length, cap_t cap,
         return EXCEPTION_SYSCALL_ERROR;
     }
 
+#ifdef CONFIG_KERNEL_CNODE_BATCH
+    if (invLabel == CNodeBatch) {
+        word_t numEntries;
+
+        if (length < 1 || current_extra_caps.excaprefs[0] == NULL || buffer == NULL) {
+            userError("CNode Batch: Truncated message.");
+            current_syscall_error.type = seL4_TruncatedMessage;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        /* The outcome of each entry is written back into the IPC buffer. */
+        if (lookupIPCBuffer(true, NODE_STATE(ksCurThread)) == NULL) {
+            userError("CNode Batch: IPC buffer is not writable.");
+            current_syscall_error.type = seL4_IllegalOperation;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        numEntries = getSyscallArg(0, buffer);
+        if (numEntries < 1 || numEntries > seL4_CNodeBatchMaxEntries) {
+            userError("CNode Batch: Number of entries (%d) too small or large.", (int)numEntries);
+            current_syscall_error.type = seL4_RangeError;
+            current_syscall_error.rangeErrorMin = 1;
+            current_syscall_error.rangeErrorMax = seL4_CNodeBatchMaxEntries;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        /* The slot of the invoked cap, which was looked up just before */
+        lookupSlot_raw_ret_t root_ret = lookupSlot(NODE_STATE(ksCurThread),
+                                                   getRegister(NODE_STATE(ksCurThread), capRegister));
+        if (root_ret.status != EXCEPTION_NONE) {
+            current_syscall_error.type = seL4_FailedLookup;
+            current_syscall_error.failedLookupWasSource = false;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+        return invokeCNodeBatch(root_ret.slot, current_extra_caps.excaprefs[0], numEntries,
+                                call, buffer);
+    }
+#endif
+
     if (length < 2) {
         userError("CNode operation: Truncated message.");
         current_syscall_error.type = seL4_TruncatedMessage;
@@ -71,6 +121,18 @@ exception_t decodeCNodeInvocation(word_t invLabel, word_t length, cap_t cap,
     }
     destSlot = lu_ret.slot;
 
+#ifdef CONFIG_KERNEL_MDB_STATS
+    if (invLabel == CNodeMDBStats) {
+        if (mdbStatsWalkBusy(NODE_STATE(ksCurThread))) {
+            userError("CNode MDBStats: Another thread has a walk in progress.");
+            current_syscall_error.type = seL4_IllegalOperation;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+        return invokeCNodeMDBStats(destSlot, call);
+    }
+#endif
+
     if (invLabel >= CNodeCopy && invLabel <= CNodeMutate) {
         cte_t *srcSlot;
         word_t srcIndex, srcDepth, capData;
@@ -333,6 +395,386 @@ exception_t invokeCNodeCancelBadgedSends(cap_t cap)
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_KERNEL_CNODE_BATCH
+/* Apply one entry of a CNode batch, with the same checks as the corresponding
+ * single CNode invocation. */
+static exception_t performCNodeBatchEntry(cap_t destRoot, cap_t srcRoot, word_t *entry)
+{
+    word_t op = entry[0] & MASK(seL4_CNodeBatchDestDepthShift);
+    word_t destDepth = (entry[0] >> seL4_CNodeBatchDestDepthShift) & MASK(8);
+    word_t srcDepth = (entry[0] >> seL4_CNodeBatchSrcDepthShift) & MASK(8);
+    seL4_CapRights_t cap_rights = rightsFromWord(entry[0] >> seL4_CNodeBatchRightsShift);
+    lookupSlot_ret_t lu_ret;
+    deriveCap_ret_t dc_ret;
+    cte_t *destSlot, *srcSlot;
+    cap_t srcCap;
+    exception_t status;
+
+    lu_ret = lookupTargetSlot(destRoot, entry[1], destDepth);
+    if (lu_ret.status != EXCEPTION_NONE) {
+        return lu_ret.status;
+    }
+    destSlot = lu_ret.slot;
+
+    if (op == seL4_CNodeBatch_Delete) {
+        return cteDelete(destSlot, true);
+    }
+
+    if (op < seL4_CNodeBatch_Copy || op > seL4_CNodeBatch_Move) {
+        current_syscall_error.type = seL4_InvalidArgument;
+        current_syscall_error.invalidArgumentNumber = 0;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    status = ensureEmptySlot(destSlot);
+    if (status != EXCEPTION_NONE) {
+        return status;
+    }
+
+    lu_ret = lookupSourceSlot(srcRoot, entry[2], srcDepth);
+    if (lu_ret.status != EXCEPTION_NONE) {
+        return lu_ret.status;
+    }
+    srcSlot = lu_ret.slot;
+
+    if (cap_get_capType(srcSlot->cap) == cap_null_cap) {
+        current_syscall_error.type = seL4_FailedLookup;
+        current_syscall_error.failedLookupWasSource = 1;
+        current_lookup_fault = lookup_fault_missing_capability_new(srcDepth);
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (op == seL4_CNodeBatch_Move) {
+        cteMove(srcSlot->cap, srcSlot, destSlot);
+        return EXCEPTION_NONE;
+    }
+
+    srcCap = maskCapRights(cap_rights, srcSlot->cap);
+    if (op == seL4_CNodeBatch_Mint) {
+        srcCap = updateCapData(false, entry[3], srcCap);
+    }
+    dc_ret = deriveCap(srcSlot, srcCap);
+    if (dc_ret.status != EXCEPTION_NONE) {
+        return dc_ret.status;
+    }
+    if (cap_get_capType(dc_ret.cap) == cap_null_cap) {
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    cteInsert(dc_ret.cap, srcSlot, destSlot);
+    return EXCEPTION_NONE;
+}
+
+/* Whether the slot a root CNode was looked up from still holds a cap to it. A
+ * CNode whose caps are all deleted is emptied, including any slot in it that
+ * held one of its roots, and its memory is not reused before the invocation
+ * returns, so reading the slot is safe either way. */
+static bool_t cnodeBatchRootValid(cte_t *slot, cap_t root)
+{
+    return cap_get_capType(slot->cap) == cap_cnode_cap &&
+           cap_cnode_cap_get_capCNodePtr(slot->cap) == cap_cnode_cap_get_capCNodePtr(root);
+}
+
+exception_t invokeCNodeBatch(cte_t *destRootSlot, cte_t *srcRootSlot, word_t numEntries,
+                             bool_t call, word_t *buffer)
+{
+    cap_t destRoot = destRootSlot->cap;
+    cap_t srcRoot = srcRootSlot->cap;
+    word_t i, op, failed = 0;
+    exception_t status;
+
+    /* Entries already applied are marked done in the IPC buffer, so that an
+     * invocation restarted after preemption carries on from the first entry
+     * that is not. */
+    for (i = 0; i < numEntries; i++) {
+        word_t *entry = &buffer[seL4_CNodeBatchFirstMR + i * seL4_CNodeBatchEntryWords + 1];
+        seL4_Error error = seL4_NoError;
+
+        if (entry[0] & seL4_CNodeBatch_Done) {
+            if ((entry[0] >> seL4_CNodeBatchStatusShift) != seL4_NoError) {
+                failed++;
+            }
+            continue;
+        }
+
+        op = entry[0] & MASK(seL4_CNodeBatchDestDepthShift);
+        status = performCNodeBatchEntry(destRoot, srcRoot, entry);
+        if (status == EXCEPTION_PREEMPTED) {
+            return status;
+        }
+        if (thread_state_get_tsType(NODE_STATE(ksCurThread)->tcbState) != ThreadState_Restart) {
+            /* The entry deleted the caller's own TCB */
+            return EXCEPTION_NONE;
+        }
+        if (status != EXCEPTION_NONE) {
+            error = current_syscall_error.type;
+            failed++;
+        }
+        entry[0] = seL4_CNodeBatch_Done | ((word_t)error << seL4_CNodeBatchStatusShift);
+
+        /* A delete may have removed the last cap to either root CNode, leaving
+         * destRoot or srcRoot stale. Only then restart the invocation as after
+         * a preemption, so that the roots are looked up and checked again
+         * before the remaining entries are applied. */
+        if (op == seL4_CNodeBatch_Delete &&
+            (!cnodeBatchRootValid(destRootSlot, destRoot) || !cnodeBatchRootValid(srcRootSlot, srcRoot))) {
+            return EXCEPTION_PREEMPTED;
+        }
+
+        status = preemptionPoint();
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+
+    if (thread_state_get_tsType(NODE_STATE(ksCurThread)->tcbState) != ThreadState_Restart) {
+        return EXCEPTION_NONE;
+    }
+    if (call) {
+        tcb_t *thread = NODE_STATE(ksCurThread);
+        word_t *ipcBuffer = lookupIPCBuffer(true, thread);
+
+        setRegister(thread, badgeRegister, 0);
+        setRegister(thread, msgInfoRegister, wordFromMessageInfo(
+                        seL4_MessageInfo_new(0, 0, 0, setMR(thread, ipcBuffer, 0, failed))));
+    }
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Running);
+
+    return EXCEPTION_NONE;
+}
+#endif
+
+#ifdef CONFIG_KERNEL_MDB_STATS
+/* State of an MDB statistics walk. It is kept across preemptions of the
+ * invocation and belongs to the thread that started it. The stack holds the ancestors of the last slot visited together
+ * with the number of children seen so far for each. The cursor and the stack
+ * are kept in the MDB by the functions below as slots are moved and removed,
+ * so that the walk resumes from where it stopped whatever else changes. */
+static struct mdb_stats_walk {
+    tcb_t *thread;
+    cte_t *root;
+    cte_t *cursor;
+    word_t depth;
+    struct {
+        cte_t *slot;
+        word_t children;
+    } stack[seL4_MDBStatsMaxDepth];
+    struct {
+        word_t descendants;
+        word_t children;
+        word_t maxDepth;
+        word_t maxFanout;
+        word_t deepNodes;
+        word_t fanout[seL4_MDBStatsFanoutBuckets];
+        word_t types[seL4_MDBStatsTypeCount];
+    } stats;
+} mdbStatsWalk;
+
+/* Other threads cannot start a walk while the owner of an unfinished one is
+ * still restarting its invocation. Once the owner is deleted, suspended or
+ * runs again without finishing, the walk is abandoned and can be replaced. */
+static bool_t mdbStatsWalkBusy(tcb_t *thread)
+{
+    return mdbStatsWalk.depth > 0 && mdbStatsWalk.thread != NULL && mdbStatsWalk.thread != thread &&
+           thread_state_get_tsType(mdbStatsWalk.thread->tcbState) == ThreadState_Restart;
+}
+
+void mdbStatsThreadDeleted(tcb_t *thread)
+{
+    if (mdbStatsWalk.thread == thread) {
+        mdbStatsWalk.thread = NULL;
+    }
+}
+
+static word_t CONST mdbStatsType(cap_t cap)
+{
+    switch (cap_get_capType(cap)) {
+    case cap_untyped_cap:
+        return seL4_MDBStats_Untyped;
+    case cap_endpoint_cap:
+        return seL4_MDBStats_Endpoint;
+    case cap_notification_cap:
+        return seL4_MDBStats_Notification;
+    case cap_reply_cap:
+        return seL4_MDBStats_Reply;
+    case cap_cnode_cap:
+        return seL4_MDBStats_CNode;
+    case cap_thread_cap:
+        return seL4_MDBStats_TCB;
+    case cap_irq_handler_cap:
+        return seL4_MDBStats_IRQHandler;
+    case cap_zombie_cap:
+        return seL4_MDBStats_Zombie;
+#ifdef CONFIG_KERNEL_MCS
+    case cap_sched_context_cap:
+        return seL4_MDBStats_SchedContext;
+#endif
+    case cap_frame_cap:
+#ifdef CONFIG_ARCH_AARCH32
+    case cap_small_frame_cap:
+#endif
+        return seL4_MDBStats_Frame;
+    default:
+        return isArchCap(cap) ? seL4_MDBStats_Arch : seL4_MDBStats_Other;
+    }
+}
+
+static void mdbStatsFanout(word_t children)
+{
+    word_t bucket;
+
+    /* bucket 0 counts leaves and bucket i >= 1 a fan-out in [2^(i-1), 2^i) */
+    bucket = children == 0 ? 0 : MIN(wordBits - clzl(children), seL4_MDBStatsFanoutBuckets - 1);
+    mdbStatsWalk.stats.fanout[bucket]++;
+    mdbStatsWalk.stats.maxFanout = MAX(mdbStatsWalk.stats.maxFanout, children);
+}
+
+static void mdbStatsPop(void)
+{
+    mdbStatsWalk.depth--;
+    mdbStatsFanout(mdbStatsWalk.stack[mdbStatsWalk.depth].children);
+}
+
+static void mdbStatsSlotMoved(cte_t *srcSlot, cte_t *destSlot)
+{
+    word_t i;
+
+    if (mdbStatsWalk.cursor == srcSlot) {
+        mdbStatsWalk.cursor = destSlot;
+    }
+    for (i = 0; i < mdbStatsWalk.depth; i++) {
+        if (mdbStatsWalk.stack[i].slot == srcSlot) {
+            mdbStatsWalk.stack[i].slot = destSlot;
+        }
+    }
+}
+
+static void mdbStatsSlotsSwapped(cte_t *slot1, cte_t *slot2)
+{
+    word_t i;
+
+    for (i = 0; i < mdbStatsWalk.depth; i++) {
+        if (mdbStatsWalk.stack[i].slot == slot1) {
+            mdbStatsWalk.stack[i].slot = slot2;
+        } else if (mdbStatsWalk.stack[i].slot == slot2) {
+            mdbStatsWalk.stack[i].slot = slot1;
+        }
+    }
+    if (mdbStatsWalk.cursor == slot1) {
+        mdbStatsWalk.cursor = slot2;
+    } else if (mdbStatsWalk.cursor == slot2) {
+        mdbStatsWalk.cursor = slot1;
+    }
+}
+
+/* A removed ancestor is taken off the stack, as the MDB now makes its
+ * descendants those of its own parent, and a removed cursor steps back to the
+ * previous slot, whose successor is where the walk goes next. Caps inserted
+ * behind the cursor are not counted. */
+static void mdbStatsSlotRemoved(cte_t *slot, cte_t *prev)
+{
+    word_t i;
+
+    if (mdbStatsWalk.depth == 0) {
+        return;
+    }
+    if (mdbStatsWalk.root == slot) {
+        mdbStatsWalk.depth = 0;
+        return;
+    }
+    if (mdbStatsWalk.cursor == slot) {
+        mdbStatsWalk.cursor = prev;
+    }
+    for (i = 1; i < mdbStatsWalk.depth; i++) {
+        if (mdbStatsWalk.stack[i].slot == slot) {
+            mdbStatsFanout(mdbStatsWalk.stack[i].children);
+            mdbStatsWalk.depth--;
+            for (; i < mdbStatsWalk.depth; i++) {
+                mdbStatsWalk.stack[i] = mdbStatsWalk.stack[i + 1];
+            }
+            return;
+        }
+    }
+}
+
+exception_t invokeCNodeMDBStats(cte_t *slot, bool_t call)
+{
+    tcb_t *thread = NODE_STATE(ksCurThread);
+    cte_t *next;
+    exception_t status;
+    word_t i, j;
+
+    if (mdbStatsWalk.depth == 0 || mdbStatsWalk.thread != thread || mdbStatsWalk.root != slot) {
+        memzero(&mdbStatsWalk, sizeof(mdbStatsWalk));
+        mdbStatsWalk.thread = thread;
+        mdbStatsWalk.root = slot;
+        mdbStatsWalk.cursor = slot;
+        mdbStatsWalk.stack[0].slot = slot;
+        mdbStatsWalk.depth = 1;
+    }
+
+    /* The descendants of slot follow it in the MDB in depth-first order, so
+     * the parent of each one is its closest ancestor still on the stack. */
+    while (mdbStatsWalk.depth > 0) {
+        next = CTE_PTR(mdb_node_get_mdbNext(mdbStatsWalk.cursor->cteMDBNode));
+        while (mdbStatsWalk.depth > 0 &&
+               (next == NULL || !isMDBParentOf(mdbStatsWalk.stack[mdbStatsWalk.depth - 1].slot, next))) {
+            mdbStatsPop();
+        }
+        if (mdbStatsWalk.depth == 0) {
+            break;
+        }
+
+        mdbStatsWalk.stack[mdbStatsWalk.depth - 1].children++;
+        mdbStatsWalk.stats.descendants++;
+        if (mdbStatsWalk.depth == 1) {
+            mdbStatsWalk.stats.children++;
+        }
+        mdbStatsWalk.stats.maxDepth = MAX(mdbStatsWalk.stats.maxDepth, mdbStatsWalk.depth);
+        mdbStatsWalk.stats.types[mdbStatsType(next->cap)]++;
+
+        /* Slots deeper than the stack are counted against their ancestor at
+         * the maximum depth. */
+        if (mdbStatsWalk.depth < seL4_MDBStatsMaxDepth) {
+            mdbStatsWalk.stack[mdbStatsWalk.depth].slot = next;
+            mdbStatsWalk.stack[mdbStatsWalk.depth].children = 0;
+            mdbStatsWalk.depth++;
+        } else {
+            mdbStatsWalk.stats.deepNodes++;
+        }
+        mdbStatsWalk.cursor = next;
+
+        status = preemptionPoint();
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+
+    if (call) {
+        word_t *ipcBuffer = lookupIPCBuffer(true, thread);
+
+        setRegister(thread, badgeRegister, 0);
+        i = setMR(thread, ipcBuffer, 0, mdbStatsWalk.stats.descendants);
+        i = setMR(thread, ipcBuffer, i, mdbStatsWalk.stats.children);
+        i = setMR(thread, ipcBuffer, i, mdbStatsWalk.stats.maxDepth);
+        i = setMR(thread, ipcBuffer, i, mdbStatsWalk.stats.maxFanout);
+        i = setMR(thread, ipcBuffer, i, mdbStatsWalk.stats.deepNodes);
+        for (j = 0; j < seL4_MDBStatsFanoutBuckets; j++) {
+            i = setMR(thread, ipcBuffer, i, mdbStatsWalk.stats.fanout[j]);
+        }
+        for (j = 0; j < seL4_MDBStatsTypeCount; j++) {
+            i = setMR(thread, ipcBuffer, i, mdbStatsWalk.stats.types[j]);
+        }
+        setRegister(thread, msgInfoRegister, wordFromMessageInfo(
+                        seL4_MessageInfo_new(0, 0, 0, i)));
+    }
+    setThreadState(thread, ThreadState_Running);
+
+    return EXCEPTION_NONE;
+}
+#endif
+
 exception_t invokeCNodeInsert(cap_t cap, cte_t *srcSlot, cte_t *destSlot)
 {
     cteInsert(cap, srcSlot, destSlot);
@@ -432,6 +874,13 @@ void cteInsert(cap_t newCap, cte_t *srcSlot, cte_t *destSlot)
      * untyped from it. */
     setUntypedCapAsFull(srcCap, newCap, srcSlot);
 
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+    lookupCacheCapUpdated(newCap);
+#endif
+
+#ifdef CONFIG_KERNEL_UNTYPED_RECLAIM
+    untypedReclaimCapInserted(srcSlot, newCap);
+#endif
     destSlot->cap = newCap;
     destSlot->cteMDBNode = newMDB;
     mdb_node_ptr_set_mdbNext(&srcSlot->cteMDBNode, CTE_REF(destSlot));
@@ -453,6 +902,17 @@ void cteMove(cap_t newCap, cte_t *srcSlot, cte_t *destSlot)
     assert((cte_t *)mdb_node_get_mdbNext(destSlot->cteMDBNode) == NULL &&
            (cte_t *)mdb_node_get_mdbPrev(destSlot->cteMDBNode) == NULL);
 
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+    lookupCacheCapUpdated(srcSlot->cap);
+    lookupCacheCapUpdated(newCap);
+#endif
+
+#ifdef CONFIG_KERNEL_MDB_STATS
+    mdbStatsSlotMoved(srcSlot, destSlot);
+#endif
+#ifdef CONFIG_KERNEL_UNTYPED_RECLAIM
+    untypedReclaimSlotMoved(srcSlot, destSlot);
+#endif
     mdb = srcSlot->cteMDBNode;
     destSlot->cap = newCap;
     srcSlot->cap = cap_null_cap_new();
@@ -491,6 +951,17 @@ void cteSwap(cap_t cap1, cte_t *slot1, cap_t cap2, cte_t *slot2)
     mdb_node_t mdb1, mdb2;
     word_t next_ptr, prev_ptr;
 
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+    lookupCacheCapUpdated(cap1);
+    lookupCacheCapUpdated(cap2);
+#endif
+#ifdef CONFIG_KERNEL_MDB_STATS
+    mdbStatsSlotsSwapped(slot1, slot2);
+#endif
+#ifdef CONFIG_KERNEL_UNTYPED_RECLAIM
+    untypedReclaimSlotsSwapped(slot1, slot2);
+#endif
+
     slot1->cap = cap2;
     slot2->cap = cap1;
 
@@ -525,6 +996,49 @@ void cteSwap(cap_t cap1, cte_t *slot1, cap_t cap2, cte_t *slot2)
             CTE_REF(slot1));
 }
 
+#ifdef CONFIG_KERNEL_REVOKE_BATCH
+/* A child can be deleted as part of a batch if nothing is derived from it and
+ * finalising it cannot leave a Zombie behind, so that it is removed in one
+ * step without a preemption point. */
+static bool_t isRevokeBatchable(cte_t *slot)
+{
+    cte_t *next;
+
+    switch (cap_get_capType(slot->cap)) {
+    case cap_cnode_cap:
+    case cap_thread_cap:
+    case cap_zombie_cap:
+        return false;
+    default:
+        break;
+    }
+
+    next = CTE_PTR(mdb_node_get_mdbNext(slot->cteMDBNode));
+    return next == NULL || !isMDBParentOf(slot, next);
+}
+
+/* Delete a run of up to CONFIG_REVOKE_BATCH_SIZE batchable children of slot,
+ * which immediately follow it in the MDB. */
+static void cteRevokeBatch(cte_t *slot)
+{
+    cte_t *nextPtr;
+    word_t i;
+
+    Arch_beginRevokeBatch();
+    nextPtr = CTE_PTR(mdb_node_get_mdbNext(slot->cteMDBNode));
+    for (i = 0; i < CONFIG_REVOKE_BATCH_SIZE && nextPtr && isMDBParentOf(slot, nextPtr) &&
+         isRevokeBatchable(nextPtr); i++) {
+        finaliseCap_ret_t fc_ret;
+
+        fc_ret = finaliseCap(nextPtr->cap, isFinalCapability(nextPtr), false);
+        assert(capRemovable(fc_ret.remainder, nextPtr));
+        emptySlot(nextPtr, fc_ret.cleanupInfo);
+        nextPtr = CTE_PTR(mdb_node_get_mdbNext(slot->cteMDBNode));
+    }
+    Arch_endRevokeBatch();
+}
+#endif
+
 exception_t cteRevoke(cte_t *slot)
 {
     cte_t *nextPtr;
@@ -535,6 +1049,17 @@ exception_t cteRevoke(cte_t *slot)
     for (nextPtr = CTE_PTR(mdb_node_get_mdbNext(slot->cteMDBNode));
          nextPtr && isMDBParentOf(slot, nextPtr);
          nextPtr = CTE_PTR(mdb_node_get_mdbNext(slot->cteMDBNode))) {
+#ifdef CONFIG_KERNEL_REVOKE_BATCH
+        if (isRevokeBatchable(nextPtr)) {
+            cteRevokeBatch(slot);
+
+            status = preemptionPoint();
+            if (status != EXCEPTION_NONE) {
+                return status;
+            }
+            continue;
+        }
+#endif
         status = cteDelete(nextPtr, true);
         if (status != EXCEPTION_NONE) {
             return status;
@@ -584,6 +1109,15 @@ static void emptySlot(cte_t *slot, cap_t cleanupInfo)
             mdb_node_ptr_set_mdbFirstBadged(&next->cteMDBNode,
                                             mdb_node_get_mdbFirstBadged(next->cteMDBNode) ||
                                             mdb_node_get_mdbFirstBadged(mdbNode));
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+        lookupCacheCapUpdated(slot->cap);
+#endif
+#ifdef CONFIG_KERNEL_MDB_STATS
+        mdbStatsSlotRemoved(slot, prev);
+#endif
+#ifdef CONFIG_KERNEL_UNTYPED_RECLAIM
+        untypedReclaimSlotRemoved(slot, prev);
+#endif
         slot->cap = cap_null_cap_new();
         slot->cteMDBNode = nullMDBNode;
 
@@ -630,6 +1164,9 @@ static finaliseSlot_ret_t finaliseSlot(cte_t *slot, bool_t immediate)
             return ret;
         }
 
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+        lookupCacheCapUpdated(slot->cap);
+#endif
         slot->cap = fc_ret.remainder;
 
         if (!immediate && capCyclicZombie(fc_ret.remainder, slot)) {
@@ -747,6 +1284,12 @@ void insertNewCap(cte_t *parent, cte_t *slot, cap_t cap)
     cte_t *next;
 
     next = CTE_PTR(mdb_node_get_mdbNext(parent->cteMDBNode));
+#ifdef CONFIG_KERNEL_LOOKUP_CACHE
+    lookupCacheCapUpdated(cap);
+#endif
+#ifdef CONFIG_KERNEL_UNTYPED_RECLAIM
+    untypedReclaimCapInserted(parent, cap);
+#endif
     slot->cap = cap;
     slot->cteMDBNode = mdb_node_new(CTE_REF(next), true, true, CTE_REF(parent));
     if (next) {
@@ -812,6 +1355,20 @@ bool_t PURE isMDBParentOf(cte_t *cte_a, cte_t *cte_b)
         break;
     }
 
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap: {
+        word_t badge;
+
+        badge = cap_ring_cap_get_capRingBadge(cte_a->cap);
+        if (badge == 0) {
+            return true;
+        }
+        return (badge == cap_ring_cap_get_capRingBadge(cte_b->cap)) &&
+               !mdb_node_get_mdbFirstBadged(cte_b->cteMDBNode);
+        break;
+    }
+#endif
+
     default:
         return true;
         break;
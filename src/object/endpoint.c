@@ -412,7 +412,7 @@ void cancelAllIPC(endpoint_t *epptr)
         endpoint_ptr_set_epQueue_tail(epptr, 0);
 
         /* Set all blocked threads to restart */
-        for (; thread; thread = thread->tcbEPNext) {
+        for (; thread; thread = tcb_ptr_get_tcbEPNext(thread)) {
 #ifdef CONFIG_KERNEL_MCS
             if (thread_state_get_tsType(thread->tcbState) == ThreadState_BlockedOnReceive) {
                 reply_t *reply = REPLY_PTR(thread_state_get_replyObject(thread->tcbState));
@@ -454,7 +454,7 @@ void cancelBadgedSends(endpoint_t *epptr, word_t badge)
         for (thread = queue.head; thread; thread = next) {
             word_t b = thread_state_ptr_get_blockingIPCBadge(
                            &thread->tcbState);
-            next = thread->tcbEPNext;
+            next = tcb_ptr_get_tcbEPNext(thread);
 #ifdef CONFIG_KERNEL_MCS
             /* senders do not have reply objects in their state, and we are only cancelling sends */
             assert(thread_state_get_tsType(thread->tcbState) == ThreadState_BlockedOnSend);
@@ -250,7 +250,7 @@ void cancelAllSignals(notification_t *ntfnPtr)
         notification_ptr_set_ntfnQueue_tail(ntfnPtr, 0);
 
         /* Set all waiting threads to Restart */
-        for (; thread; thread = thread->tcbEPNext) {
+        for (; thread; thread = tcb_ptr_get_tcbEPNext(thread)) {
             setThreadState(thread, ThreadState_Restart);
 #ifdef CONFIG_KERNEL_MCS
             if (sc_sporadic(thread->tcbSchedContext)) {
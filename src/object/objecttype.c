@@ -23,6 +23,9 @@
 #endif
 #include <object/tcb.h>
 #include <object/untyped.h>
+#ifdef CONFIG_KERNEL_RING
+#include <object/ring.h>
+#endif
 #include <model/statedata.h>
 #include <kernel/thread.h>
 #include <kernel/vspace.h>
@@ -51,6 +54,10 @@ word_t getObjectSize(word_t t, word_t userObjSize)
             return userObjSize;
         case seL4_ReplyObject:
             return seL4_ReplyBits;
+#endif
+#ifdef CONFIG_KERNEL_RING
+        case seL4_RingObject:
+            return seL4_RingBits;
 #endif
         default:
             fail("Invalid object type");
@@ -132,6 +139,16 @@ finaliseCap_ret_t finaliseCap(cap_t cap, bool_t final, bool_t exposed)
         fc_ret.cleanupInfo = cap_null_cap_new();
         return fc_ret;
 
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap:
+        if (final) {
+            finaliseRing(RING_PTR(cap_ring_cap_get_capRingPtr(cap)));
+        }
+        fc_ret.remainder = cap_null_cap_new();
+        fc_ret.cleanupInfo = cap_null_cap_new();
+        return fc_ret;
+#endif
+
     case cap_reply_cap:
 #ifdef CONFIG_KERNEL_MCS
         if (final) {
@@ -198,6 +215,12 @@ finaliseCap_ret_t finaliseCap(cap_t cap, bool_t final, bool_t exposed)
             }
 #endif
             suspend(tcb);
+#ifdef CONFIG_KERNEL_MDB_STATS
+            mdbStatsThreadDeleted(tcb);
+#endif
+#ifdef CONFIG_KERNEL_UNTYPED_RECLAIM
+            untypedReclaimThreadDeleted(tcb);
+#endif
 #ifdef CONFIG_DEBUG_BUILD
             tcbDebugRemove(tcb);
 #endif
@@ -306,6 +329,15 @@ bool_t CONST sameRegionAs(cap_t cap_a, cap_t cap_b)
         }
         break;
 
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap:
+        if (cap_get_capType(cap_b) == cap_ring_cap) {
+            return cap_ring_cap_get_capRingPtr(cap_a) ==
+                   cap_ring_cap_get_capRingPtr(cap_b);
+        }
+        break;
+#endif
+
     case cap_cnode_cap:
         if (cap_get_capType(cap_b) == cap_cnode_cap) {
             return (cap_cnode_cap_get_capCNodePtr(cap_a) ==
@@ -416,6 +448,15 @@ cap_t CONST updateCapData(bool_t preserve, word_t newData, cap_t cap)
             return cap_null_cap_new();
         }
 
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap:
+        if (!preserve && cap_ring_cap_get_capRingBadge(cap) == 0) {
+            return cap_ring_cap_set_capRingBadge(cap, newData);
+        } else {
+            return cap_null_cap_new();
+        }
+#endif
+
     case cap_cnode_cap: {
         word_t guard, guardSize;
         seL4_CNode_CapData_t w = { .words = { newData } };
@@ -493,6 +534,20 @@ cap_t CONST maskCapRights(seL4_CapRights_t cap_rights, cap_t cap)
 
         return new_cap;
     }
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap: {
+        cap_t new_cap;
+
+        new_cap = cap_ring_cap_set_capRingCanSend(
+                      cap, cap_ring_cap_get_capRingCanSend(cap) &
+                      seL4_CapRights_get_capAllowWrite(cap_rights));
+        new_cap = cap_ring_cap_set_capRingCanReceive(
+                      new_cap, cap_ring_cap_get_capRingCanReceive(cap) &
+                      seL4_CapRights_get_capAllowRead(cap_rights));
+
+        return new_cap;
+    }
+#endif
     case cap_reply_cap: {
         cap_t new_cap;
 
@@ -590,6 +645,11 @@ cap_t createObject(object_t t, void *regionBase, word_t userSize, bool_t deviceM
         return cap_reply_cap_new(REPLY_REF(regionBase), true);
 #endif
 
+#ifdef CONFIG_KERNEL_RING
+    case seL4_RingObject:
+        return cap_ring_cap_new(0, true, true, RING_REF(regionBase));
+#endif
+
     default:
         fail("Invalid object type");
     }
@@ -748,7 +808,7 @@ exception_t decodeInvocation(word_t invLabel, word_t length,
             return EXCEPTION_SYSCALL_ERROR;
         }
 #endif
-        return decodeCNodeInvocation(invLabel, length, cap, buffer);
+        return decodeCNodeInvocation(invLabel, length, cap, call, buffer);
 
     case cap_untyped_cap:
         return decodeUntypedInvocation(invLabel, length, slot, cap, call, buffer);
@@ -760,6 +820,11 @@ exception_t decodeInvocation(word_t invLabel, word_t length,
         return decodeIRQHandlerInvocation(invLabel,
                                           IDX_TO_IRQT(cap_irq_handler_cap_get_capIRQ(cap)));
 
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap:
+        return decodeRingInvocation(invLabel, capIndex, cap);
+#endif
+
 #ifdef CONFIG_KERNEL_MCS
     case cap_sched_control_cap:
         if (unlikely(firstPhase)) {
@@ -843,6 +908,11 @@ word_t CONST cap_get_capSizeBits(cap_t cap)
     case cap_notification_cap:
         return seL4_NotificationBits;
 
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap:
+        return seL4_RingBits;
+#endif
+
     case cap_cnode_cap:
         return cap_cnode_cap_get_capCNodeRadix(cap) + seL4_SlotBits;
 
@@ -909,6 +979,11 @@ bool_t CONST cap_get_capIsPhysical(cap_t cap)
     case cap_notification_cap:
         return true;
 
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap:
+        return true;
+#endif
+
     case cap_cnode_cap:
         return true;
 
@@ -961,6 +1036,11 @@ void *CONST cap_get_capPtr(cap_t cap)
     case cap_notification_cap:
         return NTFN_PTR(cap_notification_cap_get_capNtfnPtr(cap));
 
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap:
+        return RING_PTR(cap_ring_cap_get_capRingPtr(cap));
+#endif
+
     case cap_cnode_cap:
         return CTE_PTR(cap_cnode_cap_get_capCNodePtr(cap));
 
@@ -1014,6 +1094,12 @@ bool_t CONST isCapRevocable(cap_t derivedCap, cap_t srcCap)
         return (cap_notification_cap_get_capNtfnBadge(derivedCap) !=
                 cap_notification_cap_get_capNtfnBadge(srcCap));
 
+#ifdef CONFIG_KERNEL_RING
+    case cap_ring_cap:
+        return (cap_ring_cap_get_capRingBadge(derivedCap) !=
+                cap_ring_cap_get_capRingBadge(srcCap));
+#endif
+
     case cap_irq_handler_cap:
         return (cap_get_capType(srcCap) ==
                 cap_irq_control_cap);
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2026, UNSW
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <config.h>
+#include <types.h>
+#include <api/failures.h>
+#include <api/invocation.h>
+#include <api/syscall.h>
+#include <machine/io.h>
+#include <object/structures.h>
+#include <object/objecttype.h>
+#include <object/cnode.h>
+#include <object/notification.h>
+#include <object/ring.h>
+#include <kernel/thread.h>
+#include <kernel/vspace.h>
+#include <model/statedata.h>
+
+/* The header is only read through the kernel window of the bound frame, so
+ * user level cannot make the kernel fault. All accesses are volatile as the
+ * producer and consumer update the header concurrently. */
+static inline volatile seL4_RingHeader *ringHeader(ring_t *ring)
+{
+    if (cap_get_capType(ring->ringBuffer.cap) == cap_null_cap) {
+        return NULL;
+    }
+    return (volatile seL4_RingHeader *)cap_get_capPtr(ring->ringBuffer.cap);
+}
+
+static inline bool_t ringHasRecords(volatile seL4_RingHeader *hdr)
+{
+    return hdr->head != hdr->tail;
+}
+
+static inline void ringSetWaiting(volatile seL4_RingHeader *hdr, word_t waiting)
+{
+    if (hdr != NULL) {
+        hdr->waiting = waiting;
+    }
+}
+
+void receiveRing(tcb_t *thread, ring_t *ring, bool_t isBlocking)
+{
+    volatile seL4_RingHeader *hdr = ringHeader(ring);
+    cap_t ntfnCap;
+
+    if (notification_ptr_get_state(&ring->ringNtfn) != NtfnState_Active && hdr != NULL) {
+        if (ringHasRecords(hdr)) {
+            setRegister(thread, badgeRegister, 0);
+            return;
+        }
+
+        if (isBlocking) {
+            /* Publish that the consumer is about to block and then look at
+             * the ring once more. This pairs with the fence a producer
+             * issues between advancing tail and reading waiting, so either
+             * the producer sees waiting set and signals, or we see its
+             * record here. */
+            hdr->waiting = 1;
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            if (ringHasRecords(hdr)) {
+                hdr->waiting = 0;
+                setRegister(thread, badgeRegister, 0);
+                return;
+            }
+        }
+    } else {
+        ringSetWaiting(hdr, 0);
+    }
+
+    ntfnCap = cap_notification_cap_new(0, true, true, NTFN_REF(&ring->ringNtfn));
+    receiveSignal(thread, ntfnCap, isBlocking);
+}
+
+void finaliseRing(ring_t *ring)
+{
+    cancelAllSignals(&ring->ringNtfn);
+    cteDeleteOne(&ring->ringBuffer);
+}
+
+static exception_t invokeRing_Signal(ring_t *ring, word_t badge)
+{
+    ringSetWaiting(ringHeader(ring), 0);
+    sendSignal(&ring->ringNtfn, badge);
+
+    return EXCEPTION_NONE;
+}
+
+static exception_t invokeRing_SetBuffer(ring_t *ring, cap_t frameCap, cte_t *frameSlot)
+{
+    cteDeleteOne(&ring->ringBuffer);
+    cteInsert(frameCap, frameSlot, &ring->ringBuffer);
+
+    return EXCEPTION_NONE;
+}
+
+static exception_t invokeRing_ClearBuffer(ring_t *ring)
+{
+    cteDeleteOne(&ring->ringBuffer);
+
+    return EXCEPTION_NONE;
+}
+
+static exception_t decodeRingSetBuffer(ring_t *ring)
+{
+    cte_t *frameSlot;
+    cap_t frameCap;
+    deriveCap_ret_t dc_ret;
+    exception_t status;
+
+    if (current_extra_caps.excaprefs[0] == NULL) {
+        userError("Ring SetBuffer: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    frameSlot = current_extra_caps.excaprefs[0];
+
+    dc_ret = deriveCap(frameSlot, frameSlot->cap);
+    if (dc_ret.status != EXCEPTION_NONE) {
+        return dc_ret.status;
+    }
+    frameCap = dc_ret.cap;
+
+    /* The same constraints as for an IPC buffer apply: a non-device frame,
+     * which the kernel can always access through its own window. */
+    status = checkValidIPCBuffer(0, frameCap);
+    if (status != EXCEPTION_NONE) {
+        return status;
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return invokeRing_SetBuffer(ring, frameCap, frameSlot);
+}
+
+exception_t decodeRingInvocation(word_t invLabel, cptr_t capIndex, cap_t cap)
+{
+    ring_t *ring = RING_PTR(cap_ring_cap_get_capRingPtr(cap));
+
+    switch (invLabel) {
+    case RingSetBuffer:
+    case RingClearBuffer:
+        if (unlikely(!cap_ring_cap_get_capRingCanReceive(cap))) {
+            userError("Ring: managing the buffer requires the read right on cap #%lu.", capIndex);
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 0;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        if (invLabel == RingSetBuffer) {
+            return decodeRingSetBuffer(ring);
+        }
+
+        setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+        return invokeRing_ClearBuffer(ring);
+
+    default:
+        /* Any other invocation of a ring signals it, as for notifications */
+        if (unlikely(!cap_ring_cap_get_capRingCanSend(cap))) {
+            userError("Attempted to invoke a read-only ring cap #%lu.", capIndex);
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 0;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+        return invokeRing_Signal(ring, cap_ring_cap_get_capRingBadge(cap));
+    }
+}
@@ -83,27 +83,27 @@ tcb_queue_t tcb_queue_remove(tcb_queue_t queue, tcb_t *tcb)
     tcb_t *before;
     tcb_t *after;
 
-    before = tcb->tcbSchedPrev;
-    after = tcb->tcbSchedNext;
+    before = tcb_ptr_get_tcbSchedPrev(tcb);
+    after = tcb_ptr_get_tcbSchedNext(tcb);
 
     if (queue.head == tcb && queue.end == tcb) {
         queue.head = NULL;
         queue.end = NULL;
     } else {
         if (queue.head == tcb) {
-            after->tcbSchedPrev = NULL;
-            tcb->tcbSchedNext = NULL;
+            tcb_ptr_set_tcbSchedPrev(after, NULL);
+            tcb_ptr_set_tcbSchedNext(tcb, NULL);
             queue.head = after;
         } else {
             if (queue.end == tcb) {
-                before->tcbSchedNext = NULL;
-                tcb->tcbSchedPrev = NULL;
+                tcb_ptr_set_tcbSchedNext(before, NULL);
+                tcb_ptr_set_tcbSchedPrev(tcb, NULL);
                 queue.end = before;
             } else {
-                before->tcbSchedNext = after;
-                after->tcbSchedPrev = before;
-                tcb->tcbSchedPrev = NULL;
-                tcb->tcbSchedNext = NULL;
+                tcb_ptr_set_tcbSchedNext(before, after);
+                tcb_ptr_set_tcbSchedPrev(after, before);
+                tcb_ptr_set_tcbSchedPrev(tcb, NULL);
+                tcb_ptr_set_tcbSchedNext(tcb, NULL);
             }
         }
     }
@@ -241,10 +241,10 @@ tcb_queue_t tcbEPAppend(tcb_t *tcb, tcb_queue_t queue)
     if (!queue.head) { /* Empty list */
         queue.head = tcb;
     } else {
-        queue.end->tcbEPNext = tcb;
+        tcb_ptr_set_tcbEPNext(queue.end, tcb);
     }
-    tcb->tcbEPPrev = queue.end;
-    tcb->tcbEPNext = NULL;
+    tcb_ptr_set_tcbEPPrev(tcb, queue.end);
+    tcb_ptr_set_tcbEPNext(tcb, NULL);
     queue.end = tcb;
 
     return queue;
@@ -254,16 +254,16 @@ tcb_queue_t tcbEPAppend(tcb_t *tcb, tcb_queue_t queue)
 /* Remove TCB from an endpoint queue */
 tcb_queue_t tcbEPDequeue(tcb_t *tcb, tcb_queue_t queue)
 {
-    if (tcb->tcbEPPrev) {
-        tcb->tcbEPPrev->tcbEPNext = tcb->tcbEPNext;
+    if (tcb_ptr_get_tcbEPPrev(tcb)) {
+        tcb_ptr_set_tcbEPNext(tcb_ptr_get_tcbEPPrev(tcb), tcb_ptr_get_tcbEPNext(tcb));
     } else {
-        queue.head = tcb->tcbEPNext;
+        queue.head = tcb_ptr_get_tcbEPNext(tcb);
     }
 
-    if (tcb->tcbEPNext) {
-        tcb->tcbEPNext->tcbEPPrev = tcb->tcbEPPrev;
+    if (tcb_ptr_get_tcbEPNext(tcb)) {
+        tcb_ptr_set_tcbEPPrev(tcb_ptr_get_tcbEPNext(tcb), tcb_ptr_get_tcbEPPrev(tcb));
     } else {
-        queue.end = tcb->tcbEPPrev;
+        queue.end = tcb_ptr_get_tcbEPPrev(tcb);
     }
 
     return queue;
@@ -301,7 +301,7 @@ static tcb_t *find_time_after(tcb_t *tcb, ticks_t new_time)
     tcb_t *after = tcb;
 
     while (time_after(after, new_time)) {
-        after = after->tcbSchedNext;
+        after = tcb_ptr_get_tcbSchedNext(after);
     }
 
     return after;
@@ -835,6 +835,47 @@ static exception_t decodeSetFlags(cap_t cap, word_t length, bool_t call, word_t
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_KERNEL_IPC_PAGE_GRANT
+static exception_t invokeSetGrantWindow(tcb_t *thread, word_t vaddr, word_t size)
+{
+    thread->tcbGrantWindowBase = vaddr;
+    thread->tcbGrantWindowSize = size;
+
+    return EXCEPTION_NONE;
+}
+
+static exception_t decodeSetGrantWindow(cap_t cap, word_t length, word_t *buffer)
+{
+    word_t vaddr, size;
+
+    if (length < 2) {
+        userError("TCB SetGrantWindow: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    vaddr = getSyscallArg(0, buffer);
+    size = getSyscallArg(1, buffer);
+
+    if (!IS_ALIGNED(vaddr, PAGE_BITS) || !IS_ALIGNED(size, PAGE_BITS)) {
+        userError("TCB SetGrantWindow: Window is not page aligned.");
+        current_syscall_error.type = seL4_AlignmentError;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    /* check against USER_TOP to catch the case where vaddr + size wrapped around */
+    if (vaddr > USER_TOP || size > USER_TOP - vaddr) {
+        userError("TCB SetGrantWindow: Window is above the user address space.");
+        current_syscall_error.type = seL4_InvalidArgument;
+        current_syscall_error.invalidArgumentNumber = 0;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return invokeSetGrantWindow(TCB_PTR(cap_thread_cap_get_capTCBPtr(cap)), vaddr, size);
+}
+#endif /* CONFIG_KERNEL_IPC_PAGE_GRANT */
+
 /* The following functions sit in the syscall error monad, but include the
  * exception cases for the preemptible bottom end, as they call the invoke
  * functions directly.  This is a significant deviation from the Haskell
@@ -931,6 +972,16 @@ exception_t decodeTCBInvocation(word_t invLabel, word_t length, cap_t cap,
     case TCBSetFlags:
         return decodeSetFlags(cap, length, call, buffer);
 
+#ifdef CONFIG_KERNEL_IPC_PAGE_GRANT
+    case TCBSetGrantWindow:
+        return decodeSetGrantWindow(cap, length, buffer);
+#endif
+
+#ifdef CONFIG_KERNEL_TCB_SPAWN
+    case TCBSpawn:
+        return decodeTCBSpawn(cap, length, slot, buffer);
+#endif
+
     default:
         /* Haskell: "throw IllegalOperation" */
         userError("TCB: Illegal operation.");
@@ -2054,19 +2105,14 @@ exception_t invokeTCB_ReadRegisters(tcb_t *tcb_src, bool_t suspendSource,
     return EXCEPTION_NONE;
 }
 
-exception_t invokeTCB_WriteRegisters(tcb_t *dest, bool_t resumeTarget,
-                                     word_t n, word_t arch, word_t *buffer)
+/* Load n registers of dest from the syscall arguments starting at first, in
+ * the order of seL4_UserContext. */
+static void writeTCBRegisters(tcb_t *dest, word_t n, word_t first, word_t *buffer)
 {
     word_t i;
     word_t pc;
-    exception_t e;
     bool_t archInfo;
 
-    e = Arch_performTransfer(arch, NODE_STATE(ksCurThread), dest);
-    if (e != EXCEPTION_NONE) {
-        return e;
-    }
-
     if (n > n_frameRegisters + n_gpRegisters) {
         n = n_frameRegisters + n_gpRegisters;
     }
@@ -2074,16 +2120,15 @@ exception_t invokeTCB_WriteRegisters(tcb_t *dest, bool_t resumeTarget,
     archInfo = Arch_getSanitiseRegisterInfo(dest);
 
     for (i = 0; i < n_frameRegisters && i < n; i++) {
-        /* Offset of 2 to get past the initial syscall arguments */
         setRegister(dest, frameRegisters[i],
                     sanitiseRegister(frameRegisters[i],
-                                     getSyscallArg(i + 2, buffer), archInfo));
+                                     getSyscallArg(i + first, buffer), archInfo));
     }
 
     for (i = 0; i < n_gpRegisters && i + n_frameRegisters < n; i++) {
         setRegister(dest, gpRegisters[i],
                     sanitiseRegister(gpRegisters[i],
-                                     getSyscallArg(i + n_frameRegisters + 2,
+                                     getSyscallArg(i + n_frameRegisters + first,
                                                    buffer), archInfo));
     }
 
@@ -2091,6 +2136,20 @@ exception_t invokeTCB_WriteRegisters(tcb_t *dest, bool_t resumeTarget,
     setNextPC(dest, pc);
 
     Arch_postModifyRegisters(dest);
+}
+
+exception_t invokeTCB_WriteRegisters(tcb_t *dest, bool_t resumeTarget,
+                                     word_t n, word_t arch, word_t *buffer)
+{
+    exception_t e;
+
+    e = Arch_performTransfer(arch, NODE_STATE(ksCurThread), dest);
+    if (e != EXCEPTION_NONE) {
+        return e;
+    }
+
+    /* Offset of 2 to get past the initial syscall arguments */
+    writeTCBRegisters(dest, n, 2, buffer);
 
     if (resumeTarget) {
         restart(dest);
@@ -2105,6 +2164,181 @@ exception_t invokeTCB_WriteRegisters(tcb_t *dest, bool_t resumeTarget,
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_KERNEL_TCB_SPAWN
+#define TCBSPAWN_ARGS 8
+
+exception_t decodeTCBSpawn(cap_t cap, word_t length, cte_t *slot, word_t *buffer)
+{
+    cte_t *bufferSlot, *cRootSlot, *vRootSlot;
+    cap_t bufferCap, cRootCap, vRootCap;
+    deriveCap_ret_t dc_ret;
+    word_t cRootData, vRootData, bufferAddr, affinity, n;
+    prio_t prio, mcp;
+    cptr_t faultEP;
+    tcb_t *thread;
+    exception_t status;
+
+    if (length < TCBSPAWN_ARGS || current_extra_caps.excaprefs[0] == NULL
+        || current_extra_caps.excaprefs[1] == NULL
+        || current_extra_caps.excaprefs[2] == NULL) {
+        userError("TCB Spawn: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    faultEP    = getSyscallArg(0, buffer);
+    cRootData  = getSyscallArg(1, buffer);
+    vRootData  = getSyscallArg(2, buffer);
+    bufferAddr = getSyscallArg(3, buffer);
+    prio       = getSyscallArg(4, buffer);
+    mcp        = getSyscallArg(5, buffer);
+    affinity   = getSyscallArg(6, buffer);
+    n          = getSyscallArg(7, buffer);
+
+    if (length - TCBSPAWN_ARGS < n) {
+        userError("TCB Spawn: Message too short for requested write size (%d/%d).",
+                  (int)(length - TCBSPAWN_ARGS), (int)n);
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    thread = TCB_PTR(cap_thread_cap_get_capTCBPtr(cap));
+    if (thread == NODE_STATE(ksCurThread)) {
+        userError("TCB Spawn: Attempted to spawn the current thread.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    /* There is no room for an authority TCB next to the space and buffer
+     * caps, so the calling thread is the authority. */
+    status = checkPrio(prio, NODE_STATE(ksCurThread));
+    if (status != EXCEPTION_NONE) {
+        userError("TCB Spawn: Requested priority %lu too high (max %lu).",
+                  (unsigned long) prio, (unsigned long) NODE_STATE(ksCurThread)->tcbMCP);
+        return status;
+    }
+
+    status = checkPrio(mcp, NODE_STATE(ksCurThread));
+    if (status != EXCEPTION_NONE) {
+        userError("TCB Spawn: Requested maximum controlled priority %lu too high (max %lu).",
+                  (unsigned long) mcp, (unsigned long) NODE_STATE(ksCurThread)->tcbMCP);
+        return status;
+    }
+
+#ifdef ENABLE_SMP_SUPPORT
+    if (affinity >= ksNumCPUs) {
+#else
+    if (affinity != 0) {
+#endif
+        userError("TCB Spawn: Requested CPU does not exist.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    cRootSlot  = current_extra_caps.excaprefs[0];
+    cRootCap   = current_extra_caps.excaprefs[0]->cap;
+    vRootSlot  = current_extra_caps.excaprefs[1];
+    vRootCap   = current_extra_caps.excaprefs[1]->cap;
+    bufferSlot = current_extra_caps.excaprefs[2];
+    bufferCap  = current_extra_caps.excaprefs[2]->cap;
+
+    if (bufferAddr == 0) {
+        bufferSlot = NULL;
+    } else {
+        dc_ret = deriveCap(bufferSlot, bufferCap);
+        if (dc_ret.status != EXCEPTION_NONE) {
+            return dc_ret.status;
+        }
+        bufferCap = dc_ret.cap;
+
+        status = checkValidIPCBuffer(bufferAddr, bufferCap);
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+
+    if (slotCapLongRunningDelete(TCB_PTR_CTE_PTR(thread, tcbCTable)) ||
+        slotCapLongRunningDelete(TCB_PTR_CTE_PTR(thread, tcbVTable))) {
+        userError("TCB Spawn: CSpace or VSpace currently being deleted.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (cRootData != 0) {
+        cRootCap = updateCapData(false, cRootData, cRootCap);
+    }
+
+    dc_ret = deriveCap(cRootSlot, cRootCap);
+    if (dc_ret.status != EXCEPTION_NONE) {
+        return dc_ret.status;
+    }
+    cRootCap = dc_ret.cap;
+
+    if (cap_get_capType(cRootCap) != cap_cnode_cap) {
+        userError("TCB Spawn: CSpace cap is invalid.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (vRootData != 0) {
+        vRootCap = updateCapData(false, vRootData, vRootCap);
+    }
+
+    dc_ret = deriveCap(vRootSlot, vRootCap);
+    if (dc_ret.status != EXCEPTION_NONE) {
+        return dc_ret.status;
+    }
+    vRootCap = dc_ret.cap;
+
+    if (!isValidVTableRoot(vRootCap)) {
+        userError("TCB Spawn: VSpace cap is invalid.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return invokeTCB_Spawn(thread, slot, faultEP, mcp, prio,
+                           cRootCap, cRootSlot, vRootCap, vRootSlot,
+                           bufferAddr, bufferCap, bufferSlot,
+                           affinity, n, buffer);
+}
+
+exception_t invokeTCB_Spawn(tcb_t *target, cte_t *slot, cptr_t faultep,
+                            prio_t mcp, prio_t priority,
+                            cap_t cRoot_newCap, cte_t *cRoot_srcSlot,
+                            cap_t vRoot_newCap, cte_t *vRoot_srcSlot,
+                            word_t bufferAddr, cap_t bufferCap, cte_t *bufferSrcSlot,
+                            word_t affinity, word_t n, word_t *buffer)
+{
+    exception_t e;
+
+    /* Installing the caps may be preempted, in which case the whole
+     * invocation is restarted. Nothing after it is preemptible. */
+    e = invokeTCB_ThreadControl(target, slot, faultep, mcp, priority,
+                                cRoot_newCap, cRoot_srcSlot,
+                                vRoot_newCap, vRoot_srcSlot,
+                                bufferAddr, bufferCap, bufferSrcSlot,
+                                thread_control_update_space |
+                                thread_control_update_ipc_buffer |
+                                thread_control_update_mcp |
+                                thread_control_update_priority);
+    if (e != EXCEPTION_NONE) {
+        return e;
+    }
+
+#ifdef ENABLE_SMP_SUPPORT
+    if (target->tcbAffinity != affinity) {
+        invokeTCB_SetAffinity(target, affinity);
+    }
+#endif
+
+    writeTCBRegisters(target, n, TCBSPAWN_ARGS, buffer);
+    restart(target);
+
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_KERNEL_TCB_SPAWN */
+
 exception_t invokeTCB_NotificationControl(tcb_t *tcb, notification_t *ntfnPtr)
 {
     if (ntfnPtr) {
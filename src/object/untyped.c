@@ -16,13 +16,155 @@
 #include <object/cnode.h>
 #include <kernel/cspace.h>
 #include <kernel/thread.h>
+#include <model/preemption.h>
+#include <model/statedata.h>
 #include <util.h>
 
+#ifdef CONFIG_KERNEL_UNTYPED_RECLAIM
+static bool_t untypedReclaimBusy(tcb_t *thread, cte_t *slot);
+#endif
+
 static word_t alignUp(word_t baseValue, word_t alignment)
 {
     return (baseValue + (BIT(alignment) - 1)) & ~MASK(alignment);
 }
 
+#if defined(CONFIG_KERNEL_LAZY_UNTYPED_ZERO) || defined(CONFIG_KERNEL_UNTYPED_RECLAIM)
+static void clearUntypedRange(cap_t cap, word_t low, word_t high)
+{
+    void *ptr = GET_OFFSET_FREE_PTR(cap_untyped_cap_get_capPtr(cap), low);
+
+    if (high - low == BIT(CONFIG_RESET_CHUNK_BITS)) {
+        clearMemory(ptr, CONFIG_RESET_CHUNK_BITS);
+    } else {
+        memzero(ptr, high - low);
+    }
+}
+#endif
+
+#ifdef CONFIG_KERNEL_LAZY_UNTYPED_ZERO
+/*
+ * With lazy zeroing a reset does not clear the memory that was in use. The
+ * free region of an untyped is instead zero apart from a dirty prefix, which
+ * is recorded in a marker in the first two words of the free region: the
+ * offset of the top of the prefix, and the offset of a second dirty interval
+ * further up, or 0 if there is none. A second interval starts with a marker
+ * of its own, whose second word is always 0. As the free region is otherwise
+ * zero, a marker reads as 0 when there is nothing left to clear.
+ *
+ * The second interval only exists while a retype is clearing memory for its
+ * objects in the middle of the dirty prefix, so that it can be preempted
+ * without losing track of the dirty memory above the objects. Device
+ * untypeds are never cleared and carry no marker.
+ */
+static word_t *untypedMarker(cap_t cap, word_t offset)
+{
+    return (word_t *)GET_OFFSET_FREE_PTR(cap_untyped_cap_get_capPtr(cap), offset);
+}
+
+static word_t untypedDirtyTop(cap_t cap)
+{
+    word_t offset = FREE_INDEX_TO_OFFSET(cap_untyped_cap_get_capFreeIndex(cap));
+    word_t *marker;
+
+    if (cap_untyped_cap_get_capIsDevice(cap) ||
+        offset >= BIT(cap_untyped_cap_get_capBlockSize(cap))) {
+        return 0;
+    }
+
+    marker = untypedMarker(cap, offset);
+    if (marker[1] != 0) {
+        return untypedMarker(cap, marker[1])[0];
+    }
+    return marker[0];
+}
+
+static void setUntypedMarker(cap_t cap, word_t offset, word_t top, word_t next)
+{
+    word_t *marker = untypedMarker(cap, offset);
+
+    assert(top > offset);
+    marker[0] = top;
+    marker[1] = next;
+}
+
+/* Clear the dirty memory in the free region down to the offset limit,
+ * working down from the top one chunk at a time so that a preempted clear
+ * resumes where it stopped. */
+static exception_t clearUntypedDirty(cte_t *slot, word_t limit)
+{
+    cap_t cap = slot->cap;
+    word_t offset = FREE_INDEX_TO_OFFSET(cap_untyped_cap_get_capFreeIndex(cap));
+    word_t top = untypedDirtyTop(cap);
+    exception_t status;
+
+    if (top <= limit) {
+        return EXCEPTION_NONE;
+    }
+
+    /* Any second interval is folded back into a single dirty prefix. */
+    setUntypedMarker(cap, offset, top, 0);
+    limit = MAX(limit, offset);
+
+    while (top > limit) {
+        word_t next = MAX(ROUND_DOWN(top - 1, CONFIG_RESET_CHUNK_BITS), limit);
+
+        clearUntypedRange(cap, next, top);
+        top = next;
+        if (top > offset) {
+            setUntypedMarker(cap, offset, top, 0);
+        }
+
+        status = preemptionPoint();
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+    return EXCEPTION_NONE;
+}
+
+/* Make the memory for new objects at [low, high) zero, and leave any dirty
+ * memory above high recorded in a marker at high, where the free index is
+ * about to move. */
+static exception_t clearUntypedForRetype(cte_t *slot, word_t low, word_t high)
+{
+    cap_t cap = slot->cap;
+    word_t offset = FREE_INDEX_TO_OFFSET(cap_untyped_cap_get_capFreeIndex(cap));
+    word_t top = untypedDirtyTop(cap);
+    word_t *marker;
+    exception_t status;
+
+    if (top <= high) {
+        return clearUntypedDirty(slot, low);
+    }
+
+    marker = untypedMarker(cap, offset);
+    if (marker[1] != high) {
+        setUntypedMarker(cap, high, top, 0);
+        setUntypedMarker(cap, offset, high, high);
+    }
+
+    while (marker[0] > low) {
+        word_t top1 = marker[0];
+        word_t next = MAX(ROUND_DOWN(top1 - 1, CONFIG_RESET_CHUNK_BITS), low);
+
+        clearUntypedRange(cap, next, top1);
+        if (next == offset) {
+            /* The marker has been cleared with the rest of the prefix, so
+             * this must complete without a preemption point. */
+            break;
+        }
+        setUntypedMarker(cap, offset, next, high);
+
+        status = preemptionPoint();
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_KERNEL_LAZY_UNTYPED_ZERO */
+
 exception_t decodeUntypedInvocation(word_t invLabel, word_t length, cte_t *slot,
                                     cap_t cap, bool_t call, word_t *buffer)
 {
@@ -40,6 +182,28 @@ exception_t decodeUntypedInvocation(word_t invLabel, word_t length, cte_t *slot,
     bool_t deviceMemory;
     bool_t reset;
 
+#ifdef CONFIG_KERNEL_LAZY_UNTYPED_ZERO
+    if (invLabel == UntypedClearFree) {
+        return decodeUntypedClearFree(slot, cap);
+    }
+#endif
+#ifdef CONFIG_KERNEL_UNTYPED_RECLAIM
+    if (invLabel == UntypedReclaim) {
+        if (untypedReclaimBusy(NODE_STATE(ksCurThread), slot)) {
+            userError("Untyped Reclaim: Another thread is reclaiming a different untyped.");
+            current_syscall_error.type = seL4_IllegalOperation;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+        return invokeUntyped_Reclaim(slot);
+    }
+#endif
+#ifdef CONFIG_KERNEL_RETYPE_BATCH
+    if (invLabel == UntypedRetypeBatch) {
+        return decodeUntypedRetypeBatch(length, slot, cap, buffer);
+    }
+#endif
+
     /* Ensure operation is valid. */
     if (invLabel != UntypedRetype) {
         userError("Untyped cap: Illegal operation attempted.");
@@ -245,6 +409,16 @@ static exception_t resetUntypedCap(cte_t *srcSlot)
         return EXCEPTION_NONE;
     }
 
+#ifdef CONFIG_KERNEL_LAZY_UNTYPED_ZERO
+    if (!deviceMemory) {
+        /* Defer clearing: the memory that was in use joins the dirty prefix. */
+        word_t top = MAX(offset, untypedDirtyTop(prev_cap));
+        srcSlot->cap = cap_untyped_cap_set_capFreeIndex(prev_cap, 0);
+        setUntypedMarker(srcSlot->cap, 0, top, 0);
+        return EXCEPTION_NONE;
+    }
+#endif
+
     /** AUXUPD: "(True, typ_region_bytes (ptr_val \<acute>regionBase)
         (unat \<acute>block_size))" */
     /** GHOSTUPD: "(True, gs_clear_region (ptr_val \<acute>regionBase)
@@ -294,6 +468,16 @@ exception_t invokeUntyped_Retype(cte_t *srcSlot,
      * transformed by getObjectSize. */
     totalObjectSize = destLength << getObjectSize(newType, userSize);
     freeRef = (word_t)retypeBase + totalObjectSize;
+
+#ifdef CONFIG_KERNEL_LAZY_UNTYPED_ZERO
+    if (!deviceMemory) {
+        status = clearUntypedForRetype(srcSlot, (word_t)retypeBase - (word_t)regionBase,
+                                       freeRef - (word_t)regionBase);
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+#endif
     srcSlot->cap = cap_untyped_cap_set_capFreeIndex(srcSlot->cap,
                                                     GET_FREE_INDEX(regionBase, freeRef));
 
@@ -303,3 +487,421 @@ exception_t invokeUntyped_Retype(cte_t *srcSlot,
 
     return EXCEPTION_NONE;
 }
+
+#ifdef CONFIG_KERNEL_LAZY_UNTYPED_ZERO
+exception_t decodeUntypedClearFree(cte_t *slot, cap_t cap)
+{
+    if (cap_untyped_cap_get_capIsDevice(cap)) {
+        userError("Untyped ClearFree: Device untypeds are not cleared.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return invokeUntyped_ClearFree(slot, ensureNoChildren(slot) == EXCEPTION_NONE);
+}
+
+exception_t invokeUntyped_ClearFree(cte_t *srcSlot, bool_t reset)
+{
+    exception_t status;
+
+    if (reset) {
+        status = resetUntypedCap(srcSlot);
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+
+    return clearUntypedDirty(srcSlot, 0);
+}
+#endif /* CONFIG_KERNEL_LAZY_UNTYPED_ZERO */
+
+#ifdef CONFIG_KERNEL_RETYPE_BATCH
+/* Entries of the batch being retyped, copied out of the IPC buffer by the
+ * decode so that the caller cannot change them before the invoke. */
+static struct retype_batch_entry {
+    object_t type;
+    word_t userSize;
+    word_t nodeOffset;
+    word_t count;
+    word_t retypeBase;
+} retypeBatch[seL4_RetypeBatchMaxEntries];
+
+exception_t decodeUntypedRetypeBatch(word_t length, cte_t *slot, cap_t cap, word_t *buffer)
+{
+    word_t nodeIndex, nodeDepth, numEntries, nodeSize;
+    word_t freeRef, regionEnd, totalObjects;
+    word_t i, j, k;
+    cte_t *rootSlot, *destCNode;
+    cap_t nodeCap;
+    lookupSlot_ret_t lu_ret;
+    exception_t status;
+    bool_t deviceMemory, reset;
+
+    if (length < 3 || current_extra_caps.excaprefs[0] == NULL || buffer == NULL) {
+        userError("Untyped RetypeBatch: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    nodeIndex  = getSyscallArg(0, buffer);
+    nodeDepth  = getSyscallArg(1, buffer);
+    numEntries = getSyscallArg(2, buffer);
+    rootSlot = current_extra_caps.excaprefs[0];
+
+    if (numEntries < 1 || numEntries > seL4_RetypeBatchMaxEntries) {
+        userError("Untyped RetypeBatch: Number of entries (%d) too small or large.",
+                  (int)numEntries);
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 1;
+        current_syscall_error.rangeErrorMax = seL4_RetypeBatchMaxEntries;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (length < seL4_RetypeBatchFirstMR + numEntries * seL4_RetypeBatchEntryWords) {
+        userError("Untyped RetypeBatch: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    /* Lookup the destination CNode shared by all entries. */
+    if (nodeDepth == 0) {
+        nodeCap = rootSlot->cap;
+    } else {
+        lu_ret = lookupTargetSlot(rootSlot->cap, nodeIndex, nodeDepth);
+        if (lu_ret.status != EXCEPTION_NONE) {
+            userError("Untyped RetypeBatch: Invalid destination address.");
+            return lu_ret.status;
+        }
+        nodeCap = lu_ret.slot->cap;
+    }
+
+    if (cap_get_capType(nodeCap) != cap_cnode_cap) {
+        userError("Untyped RetypeBatch: Destination cap invalid or read-only.");
+        current_syscall_error.type = seL4_FailedLookup;
+        current_syscall_error.failedLookupWasSource = 0;
+        current_lookup_fault = lookup_fault_missing_capability_new(nodeDepth);
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    nodeSize = 1ul << cap_cnode_cap_get_capCNodeRadix(nodeCap);
+    destCNode = CTE_PTR(cap_cnode_cap_get_capCNodePtr(nodeCap));
+
+    status = ensureNoChildren(slot);
+    if (status != EXCEPTION_NONE) {
+        freeRef = GET_FREE_REF(cap_untyped_cap_get_capPtr(cap),
+                               cap_untyped_cap_get_capFreeIndex(cap));
+        reset = false;
+    } else {
+        freeRef = cap_untyped_cap_get_capPtr(cap);
+        reset = true;
+    }
+    regionEnd = cap_untyped_cap_get_capPtr(cap) + BIT(cap_untyped_cap_get_capBlockSize(cap));
+    deviceMemory = cap_untyped_cap_get_capIsDevice(cap);
+    totalObjects = 0;
+
+    for (i = 0; i < numEntries; i++) {
+        word_t mr = seL4_RetypeBatchFirstMR + i * seL4_RetypeBatchEntryWords;
+        word_t newType     = getSyscallArg(mr, buffer);
+        word_t userObjSize = getSyscallArg(mr + 1, buffer);
+        word_t nodeOffset  = getSyscallArg(mr + 2, buffer);
+        word_t nodeWindow  = getSyscallArg(mr + 3, buffer);
+        word_t objectSize, alignedFreeRef;
+
+        if (newType >= seL4_ObjectTypeCount) {
+            userError("Untyped RetypeBatch: Invalid object type in entry %d.", (int)i);
+            current_syscall_error.type = seL4_InvalidArgument;
+            current_syscall_error.invalidArgumentNumber = mr;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        objectSize = getObjectSize(newType, userObjSize);
+        if (userObjSize >= wordBits || objectSize > seL4_MaxUntypedBits) {
+            userError("Untyped RetypeBatch: Invalid object size in entry %d.", (int)i);
+            current_syscall_error.type = seL4_RangeError;
+            current_syscall_error.rangeErrorMin = 0;
+            current_syscall_error.rangeErrorMax = seL4_MaxUntypedBits;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        if ((newType == seL4_CapTableObject && userObjSize == 0) ||
+            (newType == seL4_UntypedObject && userObjSize < seL4_MinUntypedBits)
+#ifdef CONFIG_KERNEL_MCS
+            || (newType == seL4_SchedContextObject && userObjSize < seL4_MinSchedContextBits)
+#endif
+           ) {
+            userError("Untyped RetypeBatch: Requested object size too small in entry %d.", (int)i);
+            current_syscall_error.type = seL4_InvalidArgument;
+            current_syscall_error.invalidArgumentNumber = mr + 1;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        if (deviceMemory && !Arch_isFrameType(newType) && newType != seL4_UntypedObject) {
+            userError("Untyped RetypeBatch: Creating kernel objects with device untyped");
+            current_syscall_error.type = seL4_InvalidArgument;
+            current_syscall_error.invalidArgumentNumber = mr;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        /* The fan-out limit applies to the whole batch, which bounds the
+         * non-preemptible part of the invocation as for a single Retype. */
+        if (nodeWindow < 1 || nodeWindow > CONFIG_RETYPE_FAN_OUT_LIMIT - totalObjects) {
+            userError("Untyped RetypeBatch: Number of requested objects (%d) too small or large.",
+                      (int)nodeWindow);
+            current_syscall_error.type = seL4_RangeError;
+            current_syscall_error.rangeErrorMin = 1;
+            current_syscall_error.rangeErrorMax = CONFIG_RETYPE_FAN_OUT_LIMIT - totalObjects;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        totalObjects += nodeWindow;
+
+        if (nodeOffset > nodeSize - 1 || nodeWindow > nodeSize - nodeOffset) {
+            userError("Untyped RetypeBatch: Destination window of entry %d overruns size of node.",
+                      (int)i);
+            current_syscall_error.type = seL4_RangeError;
+            current_syscall_error.rangeErrorMin = 0;
+            current_syscall_error.rangeErrorMax = nodeSize - 1;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        for (j = 0; j < i; j++) {
+            if (nodeOffset < retypeBatch[j].nodeOffset + retypeBatch[j].count &&
+                retypeBatch[j].nodeOffset < nodeOffset + nodeWindow) {
+                userError("Untyped RetypeBatch: Destination windows of entries %d and %d overlap.",
+                          (int)j, (int)i);
+                current_syscall_error.type = seL4_DeleteFirst;
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+        }
+
+        for (k = nodeOffset; k < nodeOffset + nodeWindow; k++) {
+            status = ensureEmptySlot(destCNode + k);
+            if (status != EXCEPTION_NONE) {
+                userError("Untyped RetypeBatch: Slot #%d in destination window non-empty.",
+                          (int)k);
+                return status;
+            }
+        }
+
+        /* Objects are placed one entry after another, each aligned to its
+         * own size. */
+        alignedFreeRef = alignUp(freeRef, objectSize);
+        if (alignedFreeRef < freeRef || alignedFreeRef > regionEnd ||
+            ((regionEnd - alignedFreeRef) >> objectSize) < nodeWindow) {
+            userError("Untyped RetypeBatch: Insufficient memory for entry %d.", (int)i);
+            current_syscall_error.type = seL4_NotEnoughMemory;
+            current_syscall_error.memoryLeft = regionEnd - freeRef;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        retypeBatch[i].type = newType;
+        retypeBatch[i].userSize = userObjSize;
+        retypeBatch[i].nodeOffset = nodeOffset;
+        retypeBatch[i].count = nodeWindow;
+        retypeBatch[i].retypeBase = alignedFreeRef;
+        freeRef = alignedFreeRef + (nodeWindow << objectSize);
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return invokeUntyped_RetypeBatch(slot, reset, destCNode, numEntries, deviceMemory);
+}
+
+exception_t invokeUntyped_RetypeBatch(cte_t *srcSlot, bool_t reset, cte_t *destCNode,
+                                      word_t numEntries, bool_t deviceMemory)
+{
+    void *regionBase = WORD_PTR(cap_untyped_cap_get_capPtr(srcSlot->cap));
+    word_t i;
+    exception_t status;
+
+    if (reset) {
+        status = resetUntypedCap(srcSlot);
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+
+#ifdef CONFIG_KERNEL_LAZY_UNTYPED_ZERO
+    /* Clear for the whole batch before creating anything, so that a
+     * preempted clear restarts the invocation from scratch. */
+    if (!deviceMemory) {
+        struct retype_batch_entry *last = &retypeBatch[numEntries - 1];
+        status = clearUntypedForRetype(srcSlot, retypeBatch[0].retypeBase - (word_t)regionBase,
+                                       last->retypeBase + (last->count << getObjectSize(last->type, last->userSize))
+                                       - (word_t)regionBase);
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+#endif
+
+    for (i = 0; i < numEntries; i++) {
+        struct retype_batch_entry *entry = &retypeBatch[i];
+        word_t freeRef = entry->retypeBase + (entry->count << getObjectSize(entry->type, entry->userSize));
+
+        srcSlot->cap = cap_untyped_cap_set_capFreeIndex(srcSlot->cap,
+                                                        GET_FREE_INDEX(regionBase, freeRef));
+        createNewObjects(entry->type, srcSlot, destCNode, entry->nodeOffset, entry->count,
+                         (void *)entry->retypeBase, entry->userSize, deviceMemory);
+    }
+
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_KERNEL_RETYPE_BATCH */
+
+#ifdef CONFIG_KERNEL_UNTYPED_RECLAIM
+/* State of a reclaim scan over the children of an untyped. It is kept across
+ * preemptions of the invocation, together with the thread that last invoked
+ * it. The cursor is the last slot visited, and is
+ * kept in the MDB by the functions below as slots are inserted, moved and
+ * removed, so that the scan resumes from it whatever else changes. */
+static struct untyped_reclaim {
+    tcb_t *thread;
+    cte_t *slot;
+    cte_t *cursor;
+    word_t top;
+    bool_t scanned;
+} untypedReclaim;
+
+/* The progress of a reclaim is a property of the untyped, so any thread can
+ * continue it. A reclaim of another untyped fails while the thread of the
+ * unfinished one is still restarting its invocation. Once that thread is
+ * deleted, suspended or runs again without finishing, the reclaim is
+ * abandoned and can be replaced. */
+static bool_t untypedReclaimBusy(tcb_t *thread, cte_t *slot)
+{
+    return untypedReclaim.slot != NULL && untypedReclaim.slot != slot &&
+           untypedReclaim.thread != NULL && untypedReclaim.thread != thread &&
+           thread_state_get_tsType(untypedReclaim.thread->tcbState) == ThreadState_Restart;
+}
+
+void untypedReclaimThreadDeleted(tcb_t *thread)
+{
+    if (untypedReclaim.thread == thread) {
+        untypedReclaim.thread = NULL;
+    }
+}
+
+/* Children of the untyped are inserted straight after it, and so before the
+ * cursor. Their memory is accounted for here instead. Anything else inserted
+ * before the cursor is derived from a slot that was already visited, and lies
+ * within its memory. */
+void untypedReclaimCapInserted(cte_t *parent, cap_t cap)
+{
+    word_t regionBase, ptr;
+
+    if (likely(untypedReclaim.slot != parent)) {
+        return;
+    }
+
+    regionBase = cap_untyped_cap_get_capPtr(parent->cap);
+    ptr = (word_t)cap_get_capPtr(cap);
+    if (ptr >= regionBase) {
+        untypedReclaim.top = MAX(untypedReclaim.top, ptr + BIT(cap_get_capSizeBits(cap)) - regionBase);
+    }
+}
+
+void untypedReclaimSlotMoved(cte_t *srcSlot, cte_t *destSlot)
+{
+    if (unlikely(untypedReclaim.slot == srcSlot)) {
+        untypedReclaim.slot = NULL;
+    }
+    if (unlikely(untypedReclaim.cursor == srcSlot)) {
+        untypedReclaim.cursor = destSlot;
+    }
+}
+
+void untypedReclaimSlotsSwapped(cte_t *slot1, cte_t *slot2)
+{
+    if (unlikely(untypedReclaim.slot == slot1 || untypedReclaim.slot == slot2)) {
+        untypedReclaim.slot = NULL;
+    }
+    if (unlikely(untypedReclaim.cursor == slot1)) {
+        untypedReclaim.cursor = slot2;
+    } else if (unlikely(untypedReclaim.cursor == slot2)) {
+        untypedReclaim.cursor = slot1;
+    }
+}
+
+/* The slot before a removed child is the untyped or another of its children,
+ * so the scan steps back to it. */
+void untypedReclaimSlotRemoved(cte_t *slot, cte_t *prev)
+{
+    if (unlikely(untypedReclaim.slot == slot)) {
+        untypedReclaim.slot = NULL;
+    }
+    if (unlikely(untypedReclaim.cursor == slot)) {
+        untypedReclaim.cursor = prev;
+    }
+}
+
+exception_t invokeUntyped_Reclaim(cte_t *srcSlot)
+{
+    word_t regionBase = cap_untyped_cap_get_capPtr(srcSlot->cap);
+    word_t offset, target;
+    cte_t *next;
+    exception_t status;
+
+    untypedReclaim.thread = NODE_STATE(ksCurThread);
+    if (untypedReclaim.slot != srcSlot) {
+        untypedReclaim.slot = srcSlot;
+        untypedReclaim.cursor = srcSlot;
+        untypedReclaim.top = 0;
+        untypedReclaim.scanned = false;
+    }
+
+    /* All descendants of the untyped follow it in the MDB, and each of them
+     * lies within its region, so the highest end of any of them bounds the
+     * memory that is still in use. */
+    while (!untypedReclaim.scanned) {
+        next = CTE_PTR(mdb_node_get_mdbNext(untypedReclaim.cursor->cteMDBNode));
+        if (next == NULL || !isMDBParentOf(srcSlot, next)) {
+            untypedReclaim.scanned = true;
+            break;
+        }
+
+        untypedReclaim.top = MAX(untypedReclaim.top,
+                                 (word_t)cap_get_capPtr(next->cap) + BIT(cap_get_capSizeBits(next->cap))
+                                 - regionBase);
+        untypedReclaim.cursor = next;
+
+        status = preemptionPoint();
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+
+    target = untypedReclaim.top == 0 ? 0 : ROUND_UP(untypedReclaim.top, seL4_MinUntypedBits);
+    offset = FREE_INDEX_TO_OFFSET(cap_untyped_cap_get_capFreeIndex(srcSlot->cap));
+
+    if (offset > target) {
+        if (cap_untyped_cap_get_capIsDevice(srcSlot->cap)) {
+            srcSlot->cap = cap_untyped_cap_set_capFreeIndex(srcSlot->cap, OFFSET_TO_FREE_INDEX(target));
+        } else {
+#ifdef CONFIG_KERNEL_LAZY_UNTYPED_ZERO
+            /* The reclaimed memory joins the dirty prefix. */
+            word_t top = MAX(offset, untypedDirtyTop(srcSlot->cap));
+            srcSlot->cap = cap_untyped_cap_set_capFreeIndex(srcSlot->cap, OFFSET_TO_FREE_INDEX(target));
+            setUntypedMarker(srcSlot->cap, target, top, 0);
+#else
+            /* Memory above the free index must be zero, so clear one chunk
+             * at a time from the top before lowering the free index past
+             * it, which keeps a preempted reclaim consistent. */
+            while (offset > target) {
+                word_t low = MAX(ROUND_DOWN(offset - 1, CONFIG_RESET_CHUNK_BITS), target);
+
+                clearUntypedRange(srcSlot->cap, low, offset);
+                srcSlot->cap = cap_untyped_cap_set_capFreeIndex(srcSlot->cap, OFFSET_TO_FREE_INDEX(low));
+                offset = low;
+
+                status = preemptionPoint();
+                if (status != EXCEPTION_NONE) {
+                    return status;
+                }
+            }
+#endif
+        }
+    }
+
+    untypedReclaim.slot = NULL;
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_KERNEL_UNTYPED_RECLAIM */